@@ -0,0 +1,61 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  allocator_py_vector.h
+ *
+ *    Description:  py_vector which takes an allocator, including the std::pmr
+ *                  polymorphic allocator, and hands it on to its elements.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 05:04:18 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  David P. Riedel (), driedel@cox.net
+ *   Organization:
+ *
+ * =====================================================================================
+ */
+
+
+#ifndef  _ALLOCATOR_PY_VECTOR_INC_
+#define  _ALLOCATOR_PY_VECTOR_INC_
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+
+#include "py_vector.h"
+
+// storage policy for basic_py_vector which uses the given allocator (rebound to our
+// variant type) for the list and also passes it on to any alternative which is
+// allocator-aware.  So, with a std::pmr::polymorphic_allocator, a list of
+// std::pmr::strings keeps both the list and the characters of its strings in the
+// same memory resource.
+//
+// NOTE: values assigned through operator[] are the caller's business.  They keep
+// whatever allocator they were created with.
+
+template<typename Alloc>
+struct allocator_storage
+{
+    template<typename V>
+        using container_t = std::vector<V, typename std::allocator_traits<Alloc>::template rebind_alloc<V>>;
+
+    static constexpr bool propagate_allocator = true;
+};
+
+template<typename Alloc, typename ...Ts>
+        using allocator_py_vector = basic_py_vector<allocator_storage<Alloc>, Ts...>;
+
+// the usual case.  Build lots of these in a std::pmr::monotonic_buffer_resource and
+// throw them all away at once by releasing the resource:
+//
+//  std::pmr::monotonic_buffer_resource arena;
+//  pmr_py_vector<int, std::pmr::string> x{std::allocator_arg, &arena, {3, "a long string in the arena"}};
+
+template<typename ...Ts>
+        using pmr_py_vector = allocator_py_vector<std::pmr::polymorphic_allocator<std::byte>, Ts...>;
+
+#endif   /* ----- #ifndef _ALLOCATOR_PY_VECTOR_INC_  ----- */
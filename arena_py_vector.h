@@ -0,0 +1,747 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  arena_py_vector.h
+ *
+ *    Description:  python-like list for C++17 which keeps the characters of all its
+ *                  strings in one contiguous arena instead of one allocation each.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 08:36:14 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  David P. Riedel (), driedel@cox.net
+ *   Organization:
+ *
+ * =====================================================================================
+ */
+
+
+#ifndef  _ARENA_PY_VECTOR_INC_
+#define  _ARENA_PY_VECTOR_INC_
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+#include "py_vector.h"
+
+namespace cpp_like_py
+{
+    // where a string's characters are in its arena.
+
+    struct string_handle
+    {
+        std::uint32_t offset = 0;
+        std::uint32_t length = 0;
+    };
+
+    /*
+     * =====================================================================================
+     *        Class:  string_arena
+     *  Description:  append-only character storage.  With interning on, adding a string
+     *                which is already there gives back the existing handle.
+     * =====================================================================================
+     */
+
+    class string_arena
+    {
+        public:
+
+            string_arena() = default;
+            explicit string_arena(bool intern) : intern_{intern} { }
+
+            bool interning() const { return intern_; }
+            std::size_t size() const { return chars_.size(); }
+
+            void reserve(std::size_t new_capacity) { chars_.reserve(new_capacity); }
+
+            std::string_view view(string_handle handle) const
+            {
+                return {chars_.data() + handle.offset, handle.length};
+            }
+
+            string_handle add(std::string_view s)
+            {
+                // 's' may point into our own characters which could move when we grow.
+
+                if (! chars_.empty() && s.data() >= chars_.data() && s.data() < chars_.data() + chars_.size())
+                {
+                    return add(std::string{s});
+                }
+
+                std::size_t hash{0};
+                if (intern_)
+                {
+                    hash = std::hash<std::string_view>{}(s);
+                    auto [first, last] = interned_.equal_range(hash);
+                    for (; first != last; ++first)
+                    {
+                        if (view(first->second) == s)
+                        {
+                            return first->second;
+                        }
+                    }
+                }
+
+                if (chars_.size() + s.size() > std::numeric_limits<std::uint32_t>::max())
+                {
+                    throw std::length_error{"string_arena: more than 4GB of characters."};
+                }
+                string_handle result{static_cast<std::uint32_t>(chars_.size()), static_cast<std::uint32_t>(s.size())};
+                chars_.insert(chars_.end(), s.begin(), s.end());
+
+                if (intern_)
+                {
+                    interned_.emplace(hash, result);
+                }
+                return result;
+            }
+
+        private:
+
+            std::vector<char> chars_;
+            std::unordered_multimap<std::size_t, string_handle> interned_;
+            bool intern_ = false;
+    };
+
+    // in the arena list, std::string elements are stored as handles and read back as views.
+
+    template<typename T>
+    using arena_stored_t = std::conditional_t<std::is_same_v<T, std::string>, string_handle, T>;
+
+    template<typename T>
+    using arena_view_t = std::conditional_t<std::is_same_v<T, std::string>, std::string_view, T>;
+}		/* -----  end of namespace cpp_like_py  ----- */
+
+/*
+ * =====================================================================================
+ *        Class:  arena_py_vector
+ *  Description:  provides a Python-like list class for C++ whose std::string elements
+ *                share one contiguous block of characters.
+ * =====================================================================================
+ */
+
+// A py_vector with std::string in its type signature makes one heap allocation for
+// every string too long for the small string buffer.  Here an element holds an
+// offset/length handle into an arena owned by the list.  Copying the list copies
+// two vectors.  contains() and print_list() read the characters in order.
+//
+// Iterating gives element_views, which are variants with std::string_view in place of
+// std::string.  Assigning a string to an element adds the new characters to the
+// arena, the old ones are left behind.  erase() and assignments rebuild the arena
+// once more than half of it is left over characters.
+//
+// With interning turned on, equal strings share one copy of their characters.
+
+template<typename ...Ts>
+class arena_py_vector
+{
+    static_assert(mp11::mp_contains<mp11::mp_list<Ts...>, std::string>::value,
+            "arena_py_vector needs std::string in its type signature.");
+
+    public:
+
+        using value_type = std::variant<Ts...>;
+        using element_view = std::variant<cpp_like_py::arena_view_t<Ts>...>;
+        using stored_type = std::variant<cpp_like_py::arena_stored_t<Ts>...>;
+
+        // we don't store std::strings so we can't hand out references to them.
+        // The non-const index operator returns this proxy instead.
+
+        class reference
+        {
+            public:
+
+                reference(arena_py_vector* owner, std::size_t pos) : owner_{owner}, pos_{pos} { }
+
+                template<typename T>
+                reference& operator=(T&& value)
+                {
+                    owner_->assign_value(pos_, value_type(std::forward<T>(value)));
+                    return *this;
+                }
+
+                reference& operator=(const reference& rhs)
+                {
+                    owner_->assign_value(pos_, static_cast<value_type>(rhs));
+                    return *this;
+                }
+
+                operator value_type() const { return owner_->get_value(pos_); }
+
+                std::size_t index() const { return owner_->elements_[pos_].index(); }
+
+                bool operator==(const value_type& rhs) const { return owner_->get_value(pos_) == rhs; }
+                bool operator!=(const value_type& rhs) const { return ! (*this == rhs); }
+
+            private:
+
+                arena_py_vector* owner_;
+                std::size_t pos_;
+        };
+
+        class const_iterator
+        {
+            public:
+
+                using iterator_category = std::input_iterator_tag;
+                using value_type = element_view;
+                using difference_type = std::ptrdiff_t;
+                using pointer = void;
+                using reference = element_view;
+
+                const_iterator(const arena_py_vector* owner, std::size_t pos) : owner_{owner}, pos_{pos} { }
+
+                element_view operator*() const { return owner_->get_view(pos_); }
+
+                const_iterator& operator++() { ++pos_; return *this; }
+                const_iterator operator++(int) { auto result{*this}; ++pos_; return result; }
+
+                bool operator==(const const_iterator& rhs) const { return pos_ == rhs.pos_; }
+                bool operator!=(const const_iterator& rhs) const { return pos_ != rhs.pos_; }
+
+            private:
+
+                const arena_py_vector* owner_;
+                std::size_t pos_;
+        };
+
+        /* ====================  LIFECYCLE     ======================================= */
+        arena_py_vector () = default;                                        /* constructor */
+        ~arena_py_vector () = default;
+
+        // interning is decided when the list is made and can't be changed.
+
+        explicit arena_py_vector (bool intern_strings) : arena_{intern_strings} { }
+
+        arena_py_vector (std::initializer_list<value_type> values, bool intern_strings = false)
+            : arena_{intern_strings}
+        {
+            append(values);
+        }
+
+        arena_py_vector(const arena_py_vector& rhs) = default;
+        arena_py_vector(arena_py_vector&& rhs) noexcept = default;
+
+        template<typename S, typename ... Us>
+        explicit arena_py_vector(const basic_py_vector<S, Us...>& rhs, bool intern_strings = false)
+            : arena_{intern_strings}
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>,
+                    "rhs py_vector type signature must be proper subset to copy construct.");
+
+            elements_.reserve(rhs.size());
+            for (const auto& r_element : rhs)
+            {
+                push_foreign_value(r_element);
+            }
+        }
+
+        template<typename ...Us> friend class arena_py_vector;
+
+        /* ====================  ACCESSORS     ======================================= */
+
+        auto size() const { return elements_.size(); }
+        auto empty() const { return elements_.empty(); }
+        auto begin() const { return const_iterator{this, 0}; }
+        auto cbegin() const { return const_iterator{this, 0}; }
+        auto end() const { return const_iterator{this, elements_.size()}; }
+        auto cend() const { return const_iterator{this, elements_.size()}; }
+
+        bool interning() const { return arena_.interning(); }
+
+        // characters in the arena, including any left over from erased or replaced strings.
+
+        std::size_t arena_size() const { return arena_.size(); }
+
+        [[nodiscard]] py_vector<Ts...> to_py_vector() const
+        {
+            py_vector<Ts...> result;
+            result.reserve(elements_.size());
+            for (std::size_t i = 0; i < elements_.size(); ++i)
+            {
+                with_element(i, [&result](auto I, const auto& x)
+                {
+                    using X = std::variant_alternative_t<I, value_type>;
+                    result.template emplace<X>(X(x));
+                });
+            }
+            return result;
+        }
+
+        void print_list(std::ostream& out, const cpp_like_py::format_options& options = {}) const
+        {
+            auto& buffer = cpp_like_py::scratch_buffer();
+            format_to(buffer, options);
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        }
+
+        [[nodiscard]] std::string to_string(const cpp_like_py::format_options& options = {}) const
+        {
+            cpp_like_py::format_buffer buffer;
+            format_to(buffer, options);
+            return buffer.release();
+        }
+
+        void format_to(cpp_like_py::format_buffer& buffer, const cpp_like_py::format_options& options = {}) const
+        {
+            cpp_like_py::format_elements(buffer, begin(), end(), options);
+        }
+
+        // half open range, like Python's x[lower:upper].  The result gets its own arena
+        // holding just the strings it needs.
+
+        arena_py_vector slice(int lower_bound, int upper_bound) const
+        {
+            const auto where = py_slice{lower_bound, upper_bound}.resolve(elements_.size());
+
+            arena_py_vector result(arena_.interning());
+            result.elements_.reserve(where.count);
+            for (std::size_t i = 0; i < where.count; ++i)
+            {
+                result.push_stored(arena_, elements_[static_cast<std::size_t>(where.start + where.step * static_cast<std::ptrdiff_t>(i))]);
+            }
+            return result;
+        }
+
+        // strings can be looked for with anything which converts to a std::string_view.
+
+        template<typename Y>
+        bool contains(const Y& item) const
+        {
+            return index_of(item).has_value();
+        }
+
+        template<typename Y>
+        std::optional<std::size_t> index_of(const Y& item) const
+        {
+            for (std::size_t i = 0; i < elements_.size(); ++i)
+            {
+                if (element_equals_item(i, item))
+                {
+                    return i;
+                }
+            }
+            return std::nullopt;
+        }
+
+        template<typename Y>
+        std::size_t count(const Y& item) const
+        {
+            std::size_t result{0};
+            for (std::size_t i = 0; i < elements_.size(); ++i)
+            {
+                result += element_equals_item(i, item);
+            }
+            return result;
+        }
+
+        // this method will apply the supplied function to all list elements
+        // of the specified type.
+        // For T = std::string, a function which takes a std::string_view just reads the
+        // arena.  One which takes a std::string& gets a copy and the element is only
+        // updated when the function changes it.
+
+        template<typename T, class F>
+        void visit_all(F& func)
+        {
+            using good_type = mp11::mp_contains<new_types_set_<Ts...>, T>;
+            static_assert(std::is_same_v<good_type, mp11::mp_true>, "Type T must be in type signature of py_vector.");
+
+            for (auto& e : elements_)
+            {
+                std::visit([&](auto& x)
+                {
+                    using X = std::decay_t<decltype(x)>;
+                    if constexpr(std::is_same_v<T, std::string> && std::is_same_v<X, cpp_like_py::string_handle>)
+                    {
+                        if constexpr(std::is_invocable_v<F&, std::string_view>)
+                        {
+                            func(arena_.view(x));
+                        }
+                        else
+                        {
+                            std::string value{arena_.view(x)};
+                            func(value);
+                            if (value != arena_.view(x))
+                            {
+                                referenced_bytes_ = referenced_bytes_ - x.length + value.size();
+                                x = arena_.add(value);
+                            }
+                        }
+                    }
+                    else if constexpr(std::is_same_v<T, X>)
+                    {
+                        func(x);
+                    }
+                }, e);
+            }
+            compact_arena();
+        }
+
+        // the element at 'index' when the caller knows its type.  Strings come back as
+        // std::string_views.
+
+        template<typename T>
+        decltype(auto) get(std::size_t index) const
+        {
+            constexpr std::size_t I = mp11::mp_find<mp11::mp_list<Ts...>, T>::value;
+            const auto& x = std::get<I>(elements_.at(index));
+            if constexpr(std::is_same_v<T, std::string>)
+            {
+                return arena_.view(x);
+            }
+            else
+            {
+                return static_cast<const T&>(x);
+            }
+        }
+
+        /* ====================  MUTATORS      ======================================= */
+
+        void reserve(std::size_t new_capacity)
+        {
+            elements_.reserve(new_capacity);
+        }
+
+        arena_py_vector& append(const arena_py_vector& rhs)
+        {
+            elements_.reserve(elements_.size() + rhs.elements_.size());
+
+            // appending to ourself is fine: our own handles stay good.
+
+            const auto rhs_size = rhs.elements_.size();
+            for (std::size_t i = 0; i < rhs_size; ++i)
+            {
+                if (this == &rhs)
+                {
+                    push_stored_same_arena(elements_[i]);
+                }
+                else
+                {
+                    push_stored(rhs.arena_, rhs.elements_[i]);
+                }
+            }
+            return *this;
+        }
+
+        arena_py_vector& append(std::initializer_list<value_type> new_values)
+        {
+            elements_.reserve(elements_.size() + new_values.size());
+            for (const auto& value : new_values)
+            {
+                push_foreign_value(value);
+            }
+            return *this;
+        }
+
+        template<typename T, typename = std::enable_if_t<! std::is_same_v<std::decay_t<T>, arena_py_vector>>>
+        arena_py_vector& append(const T& element)
+        {
+            using alternative = mp11::mp_find<mp11::mp_list<Ts...>, T>;
+            static_assert(alternative::value < sizeof...(Ts), "Type T must be in type signature of py_vector.");
+
+            push_alternative<alternative::value>(element);
+            return *this;
+        }
+
+        // half open range
+
+        arena_py_vector& erase(std::size_t from, std::size_t to)
+        {
+            for (std::size_t i = from; i < to; ++i)
+            {
+                release_element(elements_[i]);
+            }
+            elements_.erase(elements_.begin() + from, elements_.begin() + to);
+            compact_arena();
+            return *this;
+        }
+
+        /* ====================  OPERATORS     ======================================= */
+
+        arena_py_vector& operator=(const arena_py_vector& rhs) = default;
+        arena_py_vector& operator=(arena_py_vector&& rhs) noexcept = default;
+
+        arena_py_vector& operator+=(const arena_py_vector& rhs)
+        {
+            return this->append(rhs);
+        }
+
+        template<typename T, typename = std::enable_if_t<! std::is_same_v<std::decay_t<T>, arena_py_vector>>>
+        arena_py_vector& operator+=(const T& element)
+        {
+            return this->append(element);
+        }
+
+        reference operator[](std::size_t index)
+        {
+            return reference{this, index};
+        }
+
+        value_type operator[](std::size_t index) const
+        {
+            return get_value(index);
+        }
+
+        template<typename ... Us>
+        bool operator==(const arena_py_vector<Us...>& rhs) const
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>,
+                    "rhs py_vector type signature must be proper subset to test equivalence.");
+
+            if (elements_.size() != rhs.elements_.size())
+            {
+                return false;
+            }
+            for (std::size_t i = 0; i < elements_.size(); ++i)
+            {
+                bool equal{false};
+                rhs.with_element(i, [&](auto, const auto& y) { equal = this->element_equals_item(i, y); });
+                if (! equal)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template<typename S, typename ... Us>
+        bool operator==(const basic_py_vector<S, Us...>& rhs) const
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>,
+                    "rhs py_vector type signature must be proper subset to test equivalence.");
+
+            if (elements_.size() != rhs.size())
+            {
+                return false;
+            }
+            std::size_t i{0};
+            for (const auto& r_element : rhs)
+            {
+                bool equal{false};
+                std::visit([&](const auto& y) { equal = this->element_equals_item(i, y); }, r_element);
+                if (! equal)
+                {
+                    return false;
+                }
+                ++i;
+            }
+            return true;
+        }
+
+    protected:
+        /* ====================  METHODS       ======================================= */
+
+        /* ====================  DATA MEMBERS  ======================================= */
+
+    private:
+        /* ====================  METHODS       ======================================= */
+
+        // calls func(I, x) with the element at 'index'.  Strings are passed as views.
+
+        template<typename F>
+        void with_element(std::size_t index, F&& func) const
+        {
+            const auto& e = elements_[index];
+            mp11::mp_with_index<sizeof...(Ts)>(e.index(), [&](auto I)
+            {
+                const auto& x = *std::get_if<I>(&e);
+                if constexpr(std::is_same_v<std::decay_t<decltype(x)>, cpp_like_py::string_handle>)
+                {
+                    func(I, arena_.view(x));
+                }
+                else
+                {
+                    func(I, x);
+                }
+            });
+        }
+
+        element_view get_view(std::size_t index) const
+        {
+            element_view result;
+            with_element(index, [&result](auto I, const auto& x) { result.template emplace<I>(x); });
+            return result;
+        }
+
+        value_type get_value(std::size_t index) const
+        {
+            if (index >= elements_.size())
+            {
+                throw std::out_of_range{"arena_py_vector index out of range"};
+            }
+            value_type result;
+            with_element(index, [&result](auto I, const auto& x)
+            {
+                using X = std::variant_alternative_t<I, value_type>;
+                result.template emplace<I>(X(x));
+            });
+            return result;
+        }
+
+        // an element matches an item only if it holds the item's type and the values are
+        // equal.  For strings, anything that converts to a std::string_view will do.
+
+        template<typename Y>
+        bool element_equals_item(std::size_t index, const Y& item) const
+        {
+            bool result{false};
+            with_element(index, [&](auto, const auto& x)
+            {
+                using X = std::decay_t<decltype(x)>;
+                if constexpr(std::is_same_v<X, std::string_view>)
+                {
+                    if constexpr(std::is_convertible_v<const Y&, std::string_view>)
+                    {
+                        result = (x == std::string_view{item});
+                    }
+                }
+                else if constexpr(std::is_same_v<X, Y>)
+                {
+                    result = (x == item);
+                }
+            });
+            return result;
+        }
+
+        template<std::size_t I, typename X>
+        void push_alternative(const X& value)
+        {
+            using T = std::variant_alternative_t<I, value_type>;
+            if constexpr(std::is_same_v<T, std::string>)
+            {
+                const auto handle = arena_.add(std::string_view{value});
+                elements_.emplace_back(std::in_place_index<I>, handle);
+                referenced_bytes_ += handle.length;
+            }
+            else
+            {
+                elements_.emplace_back(std::in_place_index<I>, value);
+            }
+        }
+
+        template<typename ...Us>
+        void push_foreign_value(const std::variant<Us...>& value)
+        {
+            using to_ours = cpp_like_py::alternative_translation<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>;
+
+            mp11::mp_with_index<sizeof...(Us)>(value.index(), [&](auto J)
+            {
+                this->template push_alternative<to_ours::value[J]>(*std::get_if<J>(&value));
+            });
+        }
+
+        // an element from another list: its string has to be copied into our arena.
+
+        void push_stored(const cpp_like_py::string_arena& from, const stored_type& value)
+        {
+            mp11::mp_with_index<sizeof...(Ts)>(value.index(), [&](auto I)
+            {
+                const auto& x = *std::get_if<I>(&value);
+                if constexpr(std::is_same_v<std::decay_t<decltype(x)>, cpp_like_py::string_handle>)
+                {
+                    this->template push_alternative<I>(from.view(x));
+                }
+                else
+                {
+                    elements_.emplace_back(std::in_place_index<I>, x);
+                }
+            });
+        }
+
+        // the arena is append-only so an element of our own list can share its characters.
+
+        void push_stored_same_arena(stored_type value)
+        {
+            std::visit([this](const auto& x)
+            {
+                if constexpr(std::is_same_v<std::decay_t<decltype(x)>, cpp_like_py::string_handle>)
+                {
+                    referenced_bytes_ += x.length;
+                }
+            }, value);
+            elements_.push_back(value);
+        }
+
+        void release_element(const stored_type& value)
+        {
+            std::visit([this](const auto& x)
+            {
+                if constexpr(std::is_same_v<std::decay_t<decltype(x)>, cpp_like_py::string_handle>)
+                {
+                    referenced_bytes_ -= x.length;
+                }
+            }, value);
+        }
+
+        void assign_value(std::size_t index, value_type&& value)
+        {
+            if (index >= elements_.size())
+            {
+                throw std::out_of_range{"arena_py_vector index out of range"};
+            }
+
+            stored_type new_element;
+            mp11::mp_with_index<sizeof...(Ts)>(value.index(), [&](auto I)
+            {
+                auto& x = *std::get_if<I>(&value);
+                if constexpr(std::is_same_v<std::decay_t<decltype(x)>, std::string>)
+                {
+                    const auto handle = arena_.add(x);
+                    new_element.template emplace<I>(handle);
+                    referenced_bytes_ += handle.length;
+                }
+                else
+                {
+                    new_element.template emplace<I>(std::move(x));
+                }
+            });
+            release_element(elements_[index]);
+            elements_[index] = new_element;
+            compact_arena();
+        }
+
+        // copy the strings still in use into a new arena once the leftovers outweigh them.
+        // With interning, shared characters are counted once per element so we may
+        // wait a little longer than we need to.
+
+        void compact_arena()
+        {
+            if (arena_.size() <= 2 * referenced_bytes_)
+            {
+                return;
+            }
+
+            cpp_like_py::string_arena new_arena{arena_.interning()};
+            new_arena.reserve(referenced_bytes_);
+            for (auto& e : elements_)
+            {
+                std::visit([&](auto& x)
+                {
+                    if constexpr(std::is_same_v<std::decay_t<decltype(x)>, cpp_like_py::string_handle>)
+                    {
+                        x = new_arena.add(arena_.view(x));
+                    }
+                }, e);
+            }
+            arena_ = std::move(new_arena);
+        }
+
+        /* ====================  DATA MEMBERS  ======================================= */
+
+        std::vector<stored_type> elements_;
+        cpp_like_py::string_arena arena_;
+
+        // total length of the strings our elements refer to.
+
+        std::size_t referenced_bytes_ = 0;
+
+}; /* ----------  end of template class arena_py_vector  ---------- */
+
+#endif   /* ----- #ifndef _ARENA_PY_VECTOR_INC_  ----- */
@@ -0,0 +1,813 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  bench.cpp
+ *
+ *    Description:  benchmarks for the py_vector hot paths, with plain
+ *                  std::vector<std::variant> and std::vector<std::any> baselines.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 11:37:40 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  David P. Riedel (), driedel@cox.net
+ *   Organization:
+ *
+ * =====================================================================================
+ */
+
+#include <any>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "py_vector.h"
+#include "concurrent_py_vector.h"
+#include "gap_py_vector.h"
+#include "nested_py_vector.h"
+#include "py_vector_text.h"
+#include "spill_py_vector.h"
+
+// run with:    make CFG=Bench bench
+//
+// which writes the results as JSON to Bench_opt/bench_results.json.  Compare two
+// runs with Google Benchmark's tools/compare.py.
+//
+// Each benchmark runs at sizes from 10 to 10M elements and over 2 type mixes:
+//      numbers     py_vector<int, double>
+//      mixed       py_vector<int, std::string, float, char>, 1 in 4 a string long
+//                  enough to need the heap.
+
+using numbers_t = py_vector<int, double>;
+using mixed_t = py_vector<int, std::string, float, char>;
+
+// same types plus one more, for the converting and cross-type operations.
+
+using wider_numbers_t = py_vector<int, double, char>;
+using wider_mixed_t = py_vector<int, std::string, float, char, double>;
+
+template<typename List> struct wider;
+template<> struct wider<numbers_t> { using type = wider_numbers_t; };
+template<> struct wider<mixed_t> { using type = wider_mixed_t; };
+
+constexpr std::int64_t smallest = 10;
+constexpr std::int64_t largest = 10'000'000;
+
+// element 'i' of a test list.  Always the same for the same i so every run sees the same data.
+
+template<typename Variant>
+Variant make_element(std::size_t i)
+{
+    if constexpr(std::is_same_v<Variant, numbers_t::value_type>)
+    {
+        if (i % 2 == 0)
+        {
+            return Variant{static_cast<int>(i)};
+        }
+        return Variant{static_cast<double>(i) * 0.5};
+    }
+    else
+    {
+        switch (i % 4)
+        {
+            case 0: return Variant{static_cast<int>(i)};
+            case 1: return Variant{"label number " + std::to_string(i)};
+            case 2: return Variant{static_cast<float>(i) * 0.5F};
+            default: return Variant{static_cast<char>('a' + i % 26)};
+        }
+    }
+}
+
+template<typename List>
+List make_list(std::size_t count)
+{
+    List result;
+    result.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::visit([&result](const auto& x) { result.append(x); }, make_element<typename List::value_type>(i));
+    }
+    return result;
+}
+
+template<typename Variant>
+std::vector<Variant> make_variants(std::size_t count)
+{
+    std::vector<Variant> result;
+    result.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        result.push_back(make_element<Variant>(i));
+    }
+    return result;
+}
+
+template<typename Variant>
+std::vector<std::any> make_anys(std::size_t count)
+{
+    std::vector<std::any> result;
+    result.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::visit([&result](const auto& x) { result.emplace_back(x); }, make_element<Variant>(i));
+    }
+    return result;
+}
+
+// a value which is never in a list so contains() looks at everything.
+
+template<typename List>
+auto missing_value()
+{
+    if constexpr(std::is_same_v<List, numbers_t>)
+    {
+        return -1;
+    }
+    else
+    {
+        return std::string{"never in the list"};
+    }
+}
+
+// somewhere for print_list to write which costs nothing.
+
+class null_buffer : public std::streambuf
+{
+    protected:
+
+        std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+        int overflow(int c) override { return c; }
+};
+
+void set_items(benchmark::State& state)
+{
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/* ====================  py_vector  ======================================= */
+
+template<typename List>
+void BM_Construct(benchmark::State& state)
+{
+    const auto source = make_variants<typename List::value_type>(state.range(0));
+    for (auto _ : state)
+    {
+        List list;
+        list.extend(source.begin(), source.end());
+        benchmark::DoNotOptimize(list);
+    }
+    set_items(state);
+}
+
+template<typename List>
+void BM_Append(benchmark::State& state)
+{
+    const auto source = make_variants<typename List::value_type>(state.range(0));
+    for (auto _ : state)
+    {
+        List list;
+        for (const auto& value : source)
+        {
+            std::visit([&list](const auto& x) { list.append(x); }, value);
+        }
+        benchmark::DoNotOptimize(list);
+    }
+    set_items(state);
+}
+
+template<typename List>
+void BM_PlusEquals(benchmark::State& state)
+{
+    const auto source = make_variants<typename List::value_type>(state.range(0));
+    for (auto _ : state)
+    {
+        List list;
+        for (const auto& value : source)
+        {
+            std::visit([&list](const auto& x) { list += x; }, value);
+        }
+        benchmark::DoNotOptimize(list);
+    }
+    set_items(state);
+}
+
+template<typename List>
+void BM_CopySameType(benchmark::State& state)
+{
+    const auto list = make_list<List>(state.range(0));
+    for (auto _ : state)
+    {
+        List copy{list};
+        benchmark::DoNotOptimize(copy);
+    }
+    set_items(state);
+}
+
+template<typename List>
+void BM_ConvertingCopy(benchmark::State& state)
+{
+    const auto list = make_list<List>(state.range(0));
+    for (auto _ : state)
+    {
+        typename wider<List>::type copy{list};
+        benchmark::DoNotOptimize(copy);
+    }
+    set_items(state);
+}
+
+template<typename List>
+void BM_ConvertingAssign(benchmark::State& state)
+{
+    const auto list = make_list<List>(state.range(0));
+    typename wider<List>::type target;
+    for (auto _ : state)
+    {
+        target = list;
+        benchmark::DoNotOptimize(target);
+    }
+    set_items(state);
+}
+
+template<typename List>
+void BM_EqualSameType(benchmark::State& state)
+{
+    const auto list = make_list<List>(state.range(0));
+    const List copy{list};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(list == copy);
+    }
+    set_items(state);
+}
+
+template<typename List>
+void BM_EqualCrossType(benchmark::State& state)
+{
+    const auto list = make_list<List>(state.range(0));
+    const typename wider<List>::type copy{list};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(copy == list);
+    }
+    set_items(state);
+}
+
+template<typename List>
+void BM_Contains(benchmark::State& state)
+{
+    const auto list = make_list<List>(state.range(0));
+    const auto value = missing_value<List>();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(list.contains(value));
+    }
+    set_items(state);
+}
+
+template<typename List>
+void BM_Slice(benchmark::State& state)
+{
+    const auto list = make_list<List>(state.range(0));
+    const auto size = static_cast<int>(list.size());
+    for (auto _ : state)
+    {
+        auto middle = list.slice(size / 4, size - size / 4);
+        benchmark::DoNotOptimize(middle);
+    }
+    set_items(state);
+}
+
+// the copy to erase from isn't timed.
+
+template<typename List>
+void BM_Erase(benchmark::State& state)
+{
+    const auto list = make_list<List>(state.range(0));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        List copy{list};
+        state.ResumeTiming();
+        copy.erase(list.size() / 4, list.size() / 2);
+        benchmark::DoNotOptimize(copy);
+    }
+    set_items(state);
+}
+
+template<typename List>
+void BM_VisitAll(benchmark::State& state)
+{
+    auto list = make_list<List>(state.range(0));
+    auto add_one([](int& x) { x += 1; });
+    for (auto _ : state)
+    {
+        list.template visit_all<int>(add_one);
+        benchmark::ClobberMemory();
+    }
+    set_items(state);
+}
+
+// the same change to every int through the bulk numeric operation.
+
+template<typename List>
+void BM_ScaleAll(benchmark::State& state)
+{
+    auto list = make_list<List>(state.range(0));
+    for (auto _ : state)
+    {
+        list.template scale_all<int>(3);
+        benchmark::ClobberMemory();
+    }
+    set_items(state);
+}
+
+// the ints as a plain column, the way a numeric pipeline wants them.
+
+template<typename List>
+void BM_ExtractInts(benchmark::State& state)
+{
+    const auto list = make_list<List>(state.range(0));
+    std::vector<int> column;
+    for (auto _ : state)
+    {
+        column.clear();
+        list.template extract_into<int>(column);
+        benchmark::DoNotOptimize(column.data());
+    }
+    set_items(state);
+}
+
+template<typename List>
+void BM_PrintList(benchmark::State& state)
+{
+    const auto list = make_list<List>(state.range(0));
+    null_buffer nowhere;
+    std::ostream out{&nowhere};
+    for (auto _ : state)
+    {
+        list.print_list(out);
+    }
+    set_items(state);
+}
+
+template<typename List>
+void BM_ToString(benchmark::State& state)
+{
+    const auto list = make_list<List>(state.range(0));
+    for (auto _ : state)
+    {
+        auto text = list.to_string();
+        benchmark::DoNotOptimize(text);
+    }
+    set_items(state);
+}
+
+/* ====================  std::vector<std::variant> baseline  ======================================= */
+
+template<typename List>
+void BM_VariantAppend(benchmark::State& state)
+{
+    const auto source = make_variants<typename List::value_type>(state.range(0));
+    for (auto _ : state)
+    {
+        std::vector<typename List::value_type> list;
+        for (const auto& value : source)
+        {
+            list.push_back(value);
+        }
+        benchmark::DoNotOptimize(list);
+    }
+    set_items(state);
+}
+
+template<typename List>
+void BM_VariantCopy(benchmark::State& state)
+{
+    const auto list = make_variants<typename List::value_type>(state.range(0));
+    for (auto _ : state)
+    {
+        auto copy{list};
+        benchmark::DoNotOptimize(copy);
+    }
+    set_items(state);
+}
+
+template<typename List>
+void BM_VariantEqual(benchmark::State& state)
+{
+    const auto list = make_variants<typename List::value_type>(state.range(0));
+    const auto copy{list};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(list == copy);
+    }
+    set_items(state);
+}
+
+template<typename List>
+void BM_VariantContains(benchmark::State& state)
+{
+    const auto list = make_variants<typename List::value_type>(state.range(0));
+    const typename List::value_type value{missing_value<List>()};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::find(list.begin(), list.end(), value) != list.end());
+    }
+    set_items(state);
+}
+
+template<typename List>
+void BM_VariantVisitAll(benchmark::State& state)
+{
+    auto list = make_variants<typename List::value_type>(state.range(0));
+    for (auto _ : state)
+    {
+        for (auto& value : list)
+        {
+            if (auto* x = std::get_if<int>(&value))
+            {
+                *x += 1;
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    set_items(state);
+}
+
+/* ====================  std::vector<std::any> baseline  ======================================= */
+
+template<typename List>
+void BM_AnyAppend(benchmark::State& state)
+{
+    const auto source = make_variants<typename List::value_type>(state.range(0));
+    for (auto _ : state)
+    {
+        std::vector<std::any> list;
+        for (const auto& value : source)
+        {
+            std::visit([&list](const auto& x) { list.emplace_back(x); }, value);
+        }
+        benchmark::DoNotOptimize(list);
+    }
+    set_items(state);
+}
+
+template<typename List>
+void BM_AnyCopy(benchmark::State& state)
+{
+    const auto list = make_anys<typename List::value_type>(state.range(0));
+    for (auto _ : state)
+    {
+        auto copy{list};
+        benchmark::DoNotOptimize(copy);
+    }
+    set_items(state);
+}
+
+template<typename List>
+void BM_AnyContains(benchmark::State& state)
+{
+    const auto list = make_anys<typename List::value_type>(state.range(0));
+    const auto value = missing_value<List>();
+    using V = decltype(value);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::any_of(list.begin(), list.end(), [&value](const std::any& a)
+        {
+            const auto* x = std::any_cast<V>(&a);
+            return x != nullptr && *x == value;
+        }));
+    }
+    set_items(state);
+}
+
+template<typename List>
+void BM_AnyVisitAll(benchmark::State& state)
+{
+    auto list = make_anys<typename List::value_type>(state.range(0));
+    for (auto _ : state)
+    {
+        for (auto& value : list)
+        {
+            if (auto* x = std::any_cast<int>(&value))
+            {
+                *x += 1;
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    set_items(state);
+}
+
+// 1000 inserts then 1000 pops, all near the front, of a list of the given size.
+
+using gap_mixed_t = gap_py_vector<int, std::string, float, char>;
+
+template<typename List>
+void BM_FrontEdits(benchmark::State& state)
+{
+    List list{make_list<mixed_t>(state.range(0))};
+    for (auto _ : state)
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            list.insert(i % 8, i);
+        }
+        for (int i = 0; i < 1000; ++i)
+        {
+            benchmark::DoNotOptimize(list.pop(i % 8));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 2000);
+}
+
+// many producers filling one list, 1000 appends per thread per iteration.  Run with
+// 1 to 32 threads.  The baseline is what we did before: a py_vector behind a mutex.
+
+constexpr int appends_per_iteration = 1000;
+
+std::unique_ptr<mixed_t> locked_list;
+std::mutex locked_list_mutex;
+
+void BM_MutexAppend(benchmark::State& state)
+{
+    if (state.thread_index() == 0)
+    {
+        locked_list = std::make_unique<mixed_t>();
+    }
+    for (auto _ : state)
+    {
+        for (int i = 0; i < appends_per_iteration; ++i)
+        {
+            std::lock_guard<std::mutex> lock{locked_list_mutex};
+            locked_list->append(i);
+        }
+    }
+    if (state.thread_index() == 0)
+    {
+        locked_list.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * appends_per_iteration);
+}
+
+std::unique_ptr<concurrent_py_vector<int, std::string, float, char>> concurrent_list;
+
+void BM_ConcurrentAppend(benchmark::State& state)
+{
+    if (state.thread_index() == 0)
+    {
+        concurrent_list = std::make_unique<concurrent_py_vector<int, std::string, float, char>>();
+    }
+    for (auto _ : state)
+    {
+        for (int i = 0; i < appends_per_iteration; ++i)
+        {
+            concurrent_list->append(i);
+        }
+    }
+    if (state.thread_index() == 0)
+    {
+        concurrent_list.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * appends_per_iteration);
+}
+
+// a front to back scan.  The spilled list gets a memory budget of a quarter of what its
+// elements take so most of every scan comes from the spill file.
+
+using spill_mixed_t = spill_py_vector<int, std::string, float, char>;
+
+template<typename List>
+void BM_ScanReduce(benchmark::State& state)
+{
+    const auto saved_defaults = cpp_like_py::spill_defaults();
+    cpp_like_py::spill_defaults().memory_budget = state.range(0) * sizeof(typename List::value_type) / 4;
+    const auto list = make_list<List>(state.range(0));
+    cpp_like_py::spill_defaults() = saved_defaults;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(list.template reduce_all<int>(0LL, std::plus<>{}));
+    }
+    set_items(state);
+}
+
+// deep copy then compare a tree of 'count' lists, each holding 8 ints and up to 4 lists.
+// The baseline is the hand rolled way: a recursive variant through a heap allocated
+// box per nested list.
+
+struct boxed_list
+{
+    using element_t = std::variant<int, std::string, std::unique_ptr<boxed_list>>;
+    std::vector<element_t> elements;
+
+    boxed_list() = default;
+    boxed_list(const boxed_list& rhs)
+    {
+        elements.reserve(rhs.elements.size());
+        for (const auto& e : rhs.elements)
+        {
+            if (const auto* box = std::get_if<std::unique_ptr<boxed_list>>(&e))
+            {
+                elements.emplace_back(std::make_unique<boxed_list>(**box));
+            }
+            else
+            {
+                elements.push_back(std::holds_alternative<int>(e) ? element_t{std::get<int>(e)} : element_t{std::get<std::string>(e)});
+            }
+        }
+    }
+
+    bool operator==(const boxed_list& rhs) const
+    {
+        if (elements.size() != rhs.elements.size())
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < elements.size(); ++i)
+        {
+            const auto* a = std::get_if<std::unique_ptr<boxed_list>>(&elements[i]);
+            const auto* b = std::get_if<std::unique_ptr<boxed_list>>(&rhs.elements[i]);
+            if (a != nullptr && b != nullptr ? ! (**a == **b) : elements[i].index() != rhs.elements[i].index() ||
+                (a == nullptr && (std::holds_alternative<int>(elements[i]) ? std::get<int>(elements[i]) != std::get<int>(rhs.elements[i])
+                    : std::get<std::string>(elements[i]) != std::get<std::string>(rhs.elements[i]))))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+void BM_BoxedTreeCopyEqual(benchmark::State& state)
+{
+    boxed_list tree;
+    std::vector<boxed_list*> lists{&tree};
+    for (std::int64_t i = 1; i < state.range(0); ++i)
+    {
+        auto& box = lists[(i - 1) / 4]->elements.emplace_back(std::make_unique<boxed_list>());
+        lists.push_back(std::get<std::unique_ptr<boxed_list>>(box).get());
+    }
+    for (auto* list : lists)
+    {
+        for (int j = 0; j < 8; ++j)
+        {
+            list->elements.emplace_back(j);
+        }
+    }
+    for (auto _ : state)
+    {
+        const boxed_list copy{tree};
+        benchmark::DoNotOptimize(copy == tree);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_NestedTreeCopyEqual(benchmark::State& state)
+{
+    using tree_t = nested_py_vector<int, std::string>;
+    tree_t tree;
+    std::vector<tree_t::list_ref> lists{tree.root()};
+    for (std::int64_t i = 1; i < state.range(0); ++i)
+    {
+        lists.push_back(lists[(i - 1) / 4].append_list());
+    }
+    for (auto& list : lists)
+    {
+        for (int j = 0; j < 8; ++j)
+        {
+            list.append(j);
+        }
+    }
+    for (auto _ : state)
+    {
+        const tree_t copy{tree};
+        benchmark::DoNotOptimize(copy == tree);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// loading 'rows' lines of CSV, 3 fields each.  The baseline is what we did before: split
+// each line into std::strings and try stoi, then stod, on each field.
+
+std::string make_csv(std::int64_t rows)
+{
+    std::string text;
+    for (std::int64_t i = 0; i < rows; ++i)
+    {
+        text += std::to_string(i) + ',' + std::to_string(i * 0.25) + ",row " + std::to_string(i) + '\n';
+    }
+    return text;
+}
+
+void BM_HandParsedCSV(benchmark::State& state)
+{
+    const std::string text{make_csv(state.range(0))};
+    for (auto _ : state)
+    {
+        mixed_t list;
+        std::istringstream in{text};
+        std::string line;
+        while (std::getline(in, line))
+        {
+            std::istringstream fields{line};
+            std::string field;
+            while (std::getline(fields, field, ','))
+            {
+                std::size_t used{0};
+                try
+                {
+                    const int i = std::stoi(field, &used);
+                    if (used == field.size())
+                    {
+                        list.append(i);
+                        continue;
+                    }
+                    const float f = std::stof(field, &used);
+                    if (used == field.size())
+                    {
+                        list.append(f);
+                        continue;
+                    }
+                }
+                catch (const std::exception&)
+                {
+                }
+                list.append(field);
+            }
+        }
+        benchmark::DoNotOptimize(list.size());
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+void BM_ParseCSV(benchmark::State& state)
+{
+    const std::string text{make_csv(state.range(0))};
+    for (auto _ : state)
+    {
+        auto list = cpp_like_py::parse_text<mixed_t>(text);
+        benchmark::DoNotOptimize(list.size());
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+#define PY_VECTOR_BENCHMARK(name) \
+    BENCHMARK_TEMPLATE(name, numbers_t)->RangeMultiplier(10)->Range(smallest, largest)->Unit(benchmark::kMicrosecond); \
+    BENCHMARK_TEMPLATE(name, mixed_t)->RangeMultiplier(10)->Range(smallest, largest)->Unit(benchmark::kMicrosecond)
+
+PY_VECTOR_BENCHMARK(BM_Construct);
+PY_VECTOR_BENCHMARK(BM_Append);
+PY_VECTOR_BENCHMARK(BM_PlusEquals);
+PY_VECTOR_BENCHMARK(BM_CopySameType);
+PY_VECTOR_BENCHMARK(BM_ConvertingCopy);
+PY_VECTOR_BENCHMARK(BM_ConvertingAssign);
+PY_VECTOR_BENCHMARK(BM_EqualSameType);
+PY_VECTOR_BENCHMARK(BM_EqualCrossType);
+PY_VECTOR_BENCHMARK(BM_Contains);
+PY_VECTOR_BENCHMARK(BM_Slice);
+PY_VECTOR_BENCHMARK(BM_Erase);
+PY_VECTOR_BENCHMARK(BM_VisitAll);
+PY_VECTOR_BENCHMARK(BM_ScaleAll);
+PY_VECTOR_BENCHMARK(BM_ExtractInts);
+PY_VECTOR_BENCHMARK(BM_PrintList);
+PY_VECTOR_BENCHMARK(BM_ToString);
+
+PY_VECTOR_BENCHMARK(BM_VariantAppend);
+PY_VECTOR_BENCHMARK(BM_VariantCopy);
+PY_VECTOR_BENCHMARK(BM_VariantEqual);
+PY_VECTOR_BENCHMARK(BM_VariantContains);
+PY_VECTOR_BENCHMARK(BM_VariantVisitAll);
+
+PY_VECTOR_BENCHMARK(BM_AnyAppend);
+PY_VECTOR_BENCHMARK(BM_AnyCopy);
+PY_VECTOR_BENCHMARK(BM_AnyContains);
+PY_VECTOR_BENCHMARK(BM_AnyVisitAll);
+
+BENCHMARK_TEMPLATE(BM_FrontEdits, mixed_t)->RangeMultiplier(10)->Range(1000, 100'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_FrontEdits, gap_mixed_t)->RangeMultiplier(10)->Range(1000, 100'000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_MutexAppend)->ThreadRange(1, 32)->UseRealTime()->Iterations(2000);
+BENCHMARK(BM_ConcurrentAppend)->ThreadRange(1, 32)->UseRealTime()->Iterations(2000);
+
+BENCHMARK_TEMPLATE(BM_ScanReduce, mixed_t)->RangeMultiplier(10)->Range(100'000, 10'000'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_ScanReduce, spill_mixed_t)->RangeMultiplier(10)->Range(100'000, 10'000'000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_BoxedTreeCopyEqual)->RangeMultiplier(10)->Range(100, 100'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_NestedTreeCopyEqual)->RangeMultiplier(10)->Range(100, 100'000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_HandParsedCSV)->RangeMultiplier(10)->Range(1000, 1'000'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ParseCSV)->RangeMultiplier(10)->Range(1000, 1'000'000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
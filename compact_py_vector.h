@@ -0,0 +1,690 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  compact_py_vector.h
+ *
+ *    Description:  python-like list for C++17 which stores each element as a 1 byte
+ *                  tag plus a small fixed size slot instead of a std::variant.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 07:41:52 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  David P. Riedel (), driedel@cox.net
+ *   Organization:
+ *
+ * =====================================================================================
+ */
+
+
+#ifndef  _COMPACT_PY_VECTOR_INC_
+#define  _COMPACT_PY_VECTOR_INC_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+
+#include "py_vector.h"
+
+namespace cpp_like_py
+{
+    // small, trivially copyable alternatives are kept right in an element's slot.
+    // Everything else goes in a side pool and the slot holds its position there.
+
+    template<typename T>
+    inline constexpr bool is_inline_alternative_v = std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(std::uint64_t);
+
+    // the slot only has to be big enough for the biggest inline alternative or a pool position.
+
+    template<typename ...Ts>
+    inline constexpr std::size_t compact_slot_size_v = std::max({sizeof(std::uint32_t),
+            (is_inline_alternative_v<Ts> ? sizeof(Ts) : sizeof(std::uint32_t))...});
+
+    template<typename ...Ts>
+    using compact_slot_t = std::conditional_t<(compact_slot_size_v<Ts...> <= sizeof(std::uint32_t)), std::uint32_t, std::uint64_t>;
+
+    template<typename T>
+    using compact_pool_t = std::conditional_t<is_inline_alternative_v<T>, std::monostate, std::vector<T>>;
+}		/* -----  end of namespace cpp_like_py  ----- */
+
+/*
+ * =====================================================================================
+ *        Class:  compact_py_vector
+ *  Description:  provides a Python-like list class for C++ in as few bytes per
+ *                element as we can manage.
+ * =====================================================================================
+ */
+
+// With std::string in the type signature, every element of a py_vector is 40 bytes,
+// even a char.  Here a char, int or float is a 1 byte tag plus a 4 byte slot.  A
+// double or int64_t makes the slots 8 bytes.  A string is a tag and a slot holding its
+// position in the container's pool of strings.
+//
+// Pool entries freed by erase or by assigning a different type are reused by later
+// appends.  When more than half of a pool is free, it is rebuilt.
+
+template<typename ...Ts>
+class compact_py_vector
+{
+    public:
+
+        using value_type = std::variant<Ts...>;
+        using tag_type = type_tag_t<sizeof...(Ts)>;
+        using slot_type = cpp_like_py::compact_slot_t<Ts...>;
+        using pools_t = std::tuple<cpp_like_py::compact_pool_t<Ts>...>;
+
+        // bytes per element, not counting anything in the pools.
+
+        static constexpr std::size_t element_size = sizeof(tag_type) + sizeof(slot_type);
+
+        // we don't store variants so we can't hand out references to them.
+        // The non-const index operator returns this proxy instead.
+
+        class reference
+        {
+            public:
+
+                reference(compact_py_vector* owner, std::size_t pos) : owner_{owner}, pos_{pos} { }
+
+                template<typename T>
+                reference& operator=(T&& value)
+                {
+                    owner_->assign_value(pos_, value_type(std::forward<T>(value)));
+                    return *this;
+                }
+
+                reference& operator=(const reference& rhs)
+                {
+                    owner_->assign_value(pos_, static_cast<value_type>(rhs));
+                    return *this;
+                }
+
+                operator value_type() const { return owner_->get_value(pos_); }
+
+                std::size_t index() const { return owner_->tags_[pos_]; }
+
+                bool operator==(const value_type& rhs) const { return owner_->get_value(pos_) == rhs; }
+                bool operator!=(const value_type& rhs) const { return ! (*this == rhs); }
+
+            private:
+
+                compact_py_vector* owner_;
+                std::size_t pos_;
+        };
+
+        // iterates in Python order.  Elements are materialized as variants as we go.
+
+        class const_iterator
+        {
+            public:
+
+                using iterator_category = std::input_iterator_tag;
+                using value_type = compact_py_vector::value_type;
+                using difference_type = std::ptrdiff_t;
+                using pointer = void;
+                using reference = value_type;
+
+                const_iterator(const compact_py_vector* owner, std::size_t pos) : owner_{owner}, pos_{pos} { }
+
+                value_type operator*() const { return owner_->get_value(pos_); }
+
+                const_iterator& operator++() { ++pos_; return *this; }
+                const_iterator operator++(int) { auto result{*this}; ++pos_; return result; }
+
+                bool operator==(const const_iterator& rhs) const { return pos_ == rhs.pos_; }
+                bool operator!=(const const_iterator& rhs) const { return pos_ != rhs.pos_; }
+
+            private:
+
+                const compact_py_vector* owner_;
+                std::size_t pos_;
+        };
+
+        /* ====================  LIFECYCLE     ======================================= */
+        compact_py_vector () = default;                                      /* constructor */
+        ~compact_py_vector () = default;
+
+        compact_py_vector (std::initializer_list<value_type> values)
+        {
+            append(values);
+        }
+
+        compact_py_vector(const compact_py_vector& rhs) = default;
+        compact_py_vector(compact_py_vector&& rhs) noexcept = default;
+
+        template<typename S, typename ... Us>
+        explicit compact_py_vector(const basic_py_vector<S, Us...>& rhs)
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>,
+                    "rhs py_vector type signature must be proper subset to copy construct.");
+
+            reserve(rhs.size());
+            for (const auto& r_element : rhs)
+            {
+                push_foreign_value(r_element);
+            }
+        }
+
+        template<typename ... Us>
+        explicit compact_py_vector(const compact_py_vector<Us...>& rhs)
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>,
+                    "rhs py_vector type signature must be proper subset to copy construct.");
+
+            reserve(rhs.size());
+            for (std::size_t i = 0; i < rhs.size(); ++i)
+            {
+                push_foreign_value(rhs.get_value(i));
+            }
+        }
+
+        template<typename ...Us> friend class compact_py_vector;
+
+        /* ====================  ACCESSORS     ======================================= */
+
+        auto size() const { return tags_.size(); }
+        auto empty() const { return tags_.empty(); }
+        auto begin() const { return const_iterator{this, 0}; }
+        auto cbegin() const { return const_iterator{this, 0}; }
+        auto end() const { return const_iterator{this, tags_.size()}; }
+        auto cend() const { return const_iterator{this, tags_.size()}; }
+
+        // same elements, same order, but stored as a regular py_vector.
+
+        [[nodiscard]] py_vector<Ts...> to_py_vector() const
+        {
+            py_vector<Ts...> result;
+            result.reserve(tags_.size());
+            for (std::size_t i = 0; i < tags_.size(); ++i)
+            {
+                with_element(i, [&result](auto /*I*/, const auto& x) { result.template emplace<std::decay_t<decltype(x)>>(x); });
+            }
+            return result;
+        }
+
+        void print_list(std::ostream& out, const cpp_like_py::format_options& options = {}) const
+        {
+            auto& buffer = cpp_like_py::scratch_buffer();
+            format_to(buffer, options);
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        }
+
+        [[nodiscard]] std::string to_string(const cpp_like_py::format_options& options = {}) const
+        {
+            cpp_like_py::format_buffer buffer;
+            format_to(buffer, options);
+            return buffer.release();
+        }
+
+        void format_to(cpp_like_py::format_buffer& buffer, const cpp_like_py::format_options& options = {}) const
+        {
+            buffer.append('[');
+
+            for (std::size_t i = 0; i < tags_.size(); ++i)
+            {
+                if (i != 0)
+                {
+                    buffer.append(", ");
+                }
+                with_element(i, [&](auto, const auto& x) { cpp_like_py::format_value(buffer, x, options); });
+            }
+            buffer.append("]\n");
+        }
+
+        // half open range, like Python's x[lower:upper].
+
+        compact_py_vector slice(int lower_bound, int upper_bound) const
+        {
+            const auto where = py_slice{lower_bound, upper_bound}.resolve(tags_.size());
+
+            compact_py_vector result;
+            result.reserve(where.count);
+            for (std::size_t i = 0; i < where.count; ++i)
+            {
+                with_element(static_cast<std::size_t>(where.start + where.step * static_cast<std::ptrdiff_t>(i)), [&result](auto I, const auto& x) { result.template push_alternative<I>(x); });
+            }
+            return result;
+        }
+
+        // scanning for an inline alternative only touches the tags and the slots.
+
+        template<typename Y>
+        bool contains(const Y& item) const
+        {
+            return index_of(item).has_value();
+        }
+
+        template<typename Y>
+        std::optional<std::size_t> index_of(const Y& item) const
+        {
+            for (std::size_t i = 0; i < tags_.size(); ++i)
+            {
+                if (element_equals_item(i, item))
+                {
+                    return i;
+                }
+            }
+            return std::nullopt;
+        }
+
+        template<typename Y>
+        std::size_t count(const Y& item) const
+        {
+            std::size_t result{0};
+            for (std::size_t i = 0; i < tags_.size(); ++i)
+            {
+                result += element_equals_item(i, item);
+            }
+            return result;
+        }
+
+        // this method will apply the supplied function to all list elements
+        // of the specified type, in list order.  Inline values are copied out of
+        // their slots for the call and copied back afterwards.
+
+        template<typename T, class F>
+        void visit_all(F& func)
+        {
+            using good_type = mp11::mp_contains<new_types_set_<Ts...>, T>;
+            static_assert(std::is_same_v<good_type, mp11::mp_true>, "Type T must be in type signature of py_vector.");
+
+            for (std::size_t i = 0; i < tags_.size(); ++i)
+            {
+                mp11::mp_with_index<sizeof...(Ts)>(tags_[i], [&](auto I)
+                {
+                    using X = std::variant_alternative_t<I, value_type>;
+                    if constexpr (std::is_same_v<T, X>)
+                    {
+                        if constexpr(cpp_like_py::is_inline_alternative_v<X>)
+                        {
+                            X x = load_inline<X>(slots_[i]);
+                            func(x);
+                            store_inline(slots_[i], x);
+                        }
+                        else
+                        {
+                            func(std::get<I>(pools_)[slots_[i]]);
+                        }
+                    }
+                });
+            }
+        }
+
+        // the element at 'index' when the caller knows its type.  Inline alternatives
+        // come back by value since there is no T to refer to.
+
+        template<typename T>
+        decltype(auto) get(std::size_t index) const
+        {
+            constexpr std::size_t I = mp11::mp_find<mp11::mp_list<Ts...>, T>::value;
+            if (tags_.at(index) != I)
+            {
+                throw std::bad_variant_access{};
+            }
+            if constexpr(cpp_like_py::is_inline_alternative_v<T>)
+            {
+                return load_inline<T>(slots_[index]);
+            }
+            else
+            {
+                return static_cast<const T&>(std::get<I>(pools_)[slots_[index]]);
+            }
+        }
+
+        /* ====================  MUTATORS      ======================================= */
+
+        void reserve(std::size_t new_capacity)
+        {
+            tags_.reserve(new_capacity);
+            slots_.reserve(new_capacity);
+        }
+
+        compact_py_vector& append(const compact_py_vector& rhs)
+        {
+            if (this != &rhs)
+            {
+                reserve(tags_.size() + rhs.tags_.size());
+                for (std::size_t i = 0; i < rhs.tags_.size(); ++i)
+                {
+                    rhs.with_element(i, [this](auto I, const auto& x) { this->template push_alternative<I>(x); });
+                }
+            }
+            return *this;
+        }
+
+        compact_py_vector& append(std::initializer_list<value_type> new_values)
+        {
+            reserve(tags_.size() + new_values.size());
+            for (const auto& value : new_values)
+            {
+                mp11::mp_with_index<sizeof...(Ts)>(value.index(), [&](auto I)
+                {
+                    this->template push_alternative<I>(*std::get_if<I>(&value));
+                });
+            }
+            return *this;
+        }
+
+        template<typename T, typename = std::enable_if_t<! std::is_same_v<std::decay_t<T>, compact_py_vector>>>
+        compact_py_vector& append(T&& element)
+        {
+            using alternative = mp11::mp_find<mp11::mp_list<Ts...>, std::decay_t<T>>;
+            static_assert(alternative::value < sizeof...(Ts), "Type T must be in type signature of py_vector.");
+
+            push_alternative<alternative::value>(std::forward<T>(element));
+            return *this;
+        }
+
+        // half open range
+
+        compact_py_vector& erase(std::size_t from, std::size_t to)
+        {
+            for (std::size_t i = from; i < to; ++i)
+            {
+                release_slot(i);
+            }
+            tags_.erase(tags_.begin() + from, tags_.begin() + to);
+            slots_.erase(slots_.begin() + from, slots_.begin() + to);
+            compact_pools();
+            return *this;
+        }
+
+        /* ====================  OPERATORS     ======================================= */
+
+        compact_py_vector& operator=(const compact_py_vector& rhs) = default;
+        compact_py_vector& operator=(compact_py_vector&& rhs) noexcept = default;
+
+        template<typename ... Us>
+        compact_py_vector& operator=(const compact_py_vector<Us...>& rhs)
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>,
+                    "rhs py_vector type signature must be proper subset to copy assign.");
+
+            // a little bit of exception safety.
+
+            compact_py_vector new_values{rhs};
+            *this = std::move(new_values);
+            return *this;
+        }
+
+        compact_py_vector& operator+=(const compact_py_vector& rhs)
+        {
+            return this->append(rhs);
+        }
+
+        template<typename T, typename = std::enable_if_t<! std::is_same_v<std::decay_t<T>, compact_py_vector>>>
+        compact_py_vector& operator+=(T&& element)
+        {
+            return this->append(std::forward<T>(element));
+        }
+
+        reference operator[](std::size_t index)
+        {
+            return reference{this, index};
+        }
+
+        value_type operator[](std::size_t index) const
+        {
+            return get_value(index);
+        }
+
+        template<typename ... Us>
+        bool operator==(const compact_py_vector<Us...>& rhs) const
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>,
+                    "rhs py_vector type signature must be proper subset to test equivalence.");
+
+            if (tags_.size() != rhs.tags_.size())
+            {
+                return false;
+            }
+            for (std::size_t i = 0; i < tags_.size(); ++i)
+            {
+                bool equal{false};
+                rhs.with_element(i, [&](auto, const auto& y) { equal = this->element_equals_item(i, y); });
+                if (! equal)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template<typename S, typename ... Us>
+        bool operator==(const basic_py_vector<S, Us...>& rhs) const
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>,
+                    "rhs py_vector type signature must be proper subset to test equivalence.");
+
+            if (tags_.size() != rhs.size())
+            {
+                return false;
+            }
+            std::size_t i{0};
+            for (const auto& r_element : rhs)
+            {
+                bool equal{false};
+                std::visit([&](const auto& y) { equal = this->element_equals_item(i, y); }, r_element);
+                if (! equal)
+                {
+                    return false;
+                }
+                ++i;
+            }
+            return true;
+        }
+
+    protected:
+        /* ====================  METHODS       ======================================= */
+
+        /* ====================  DATA MEMBERS  ======================================= */
+
+    private:
+        /* ====================  METHODS       ======================================= */
+
+        template<typename X>
+        static X load_inline(slot_type slot)
+        {
+            X x;
+            std::memcpy(&x, &slot, sizeof(X));
+            return x;
+        }
+
+        template<typename X>
+        static void store_inline(slot_type& slot, const X& x)
+        {
+            slot = 0;
+            std::memcpy(&slot, &x, sizeof(X));
+        }
+
+        // calls func(I, x) with the element at 'index' as its proper type.
+
+        template<typename F>
+        void with_element(std::size_t index, F&& func) const
+        {
+            mp11::mp_with_index<sizeof...(Ts)>(tags_[index], [&](auto I)
+            {
+                using X = std::variant_alternative_t<I, value_type>;
+                if constexpr(cpp_like_py::is_inline_alternative_v<X>)
+                {
+                    func(I, load_inline<X>(slots_[index]));
+                }
+                else
+                {
+                    func(I, std::get<I>(pools_)[slots_[index]]);
+                }
+            });
+        }
+
+        value_type get_value(std::size_t index) const
+        {
+            if (index >= tags_.size())
+            {
+                throw std::out_of_range{"compact_py_vector index out of range"};
+            }
+            value_type result;
+            with_element(index, [&result](auto I, const auto& x) { result.template emplace<I>(x); });
+            return result;
+        }
+
+        // an element matches an item only if it holds the item's type and the values are equal.
+
+        template<typename Y>
+        bool element_equals_item(std::size_t index, const Y& item) const
+        {
+            bool result{false};
+            with_element(index, [&](auto, const auto& x)
+            {
+                if constexpr(std::is_same_v<std::decay_t<decltype(x)>, Y>)
+                {
+                    result = (x == item);
+                }
+            });
+            return result;
+        }
+
+        // put a value in an element's slot, taking a free pool entry if there is one.
+
+        template<std::size_t I, typename X>
+        slot_type make_slot(X&& value)
+        {
+            using T = std::variant_alternative_t<I, value_type>;
+            if constexpr(cpp_like_py::is_inline_alternative_v<T>)
+            {
+                slot_type slot;
+                store_inline(slot, static_cast<T>(value));
+                return slot;
+            }
+            else
+            {
+                auto& pool = std::get<I>(pools_);
+                auto& free = free_[I];
+                if (! free.empty())
+                {
+                    const auto slot = free.back();
+                    pool[slot] = std::forward<X>(value);
+                    free.pop_back();
+                    return slot;
+                }
+                if (pool.size() >= std::numeric_limits<std::uint32_t>::max())
+                {
+                    throw std::length_error{"compact_py_vector: too many elements of one type."};
+                }
+                pool.push_back(std::forward<X>(value));
+                return static_cast<slot_type>(pool.size() - 1);
+            }
+        }
+
+        template<std::size_t I, typename X>
+        void push_alternative(X&& value)
+        {
+            const auto slot = make_slot<I>(std::forward<X>(value));
+            tags_.push_back(static_cast<tag_type>(I));
+            slots_.push_back(slot);
+        }
+
+        // elements from a compatible type signature go in the first of our alternatives
+        // with the same type.
+
+        template<typename ...Us>
+        void push_foreign_value(const std::variant<Us...>& value)
+        {
+            using to_ours = cpp_like_py::alternative_translation<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>;
+
+            mp11::mp_with_index<sizeof...(Us)>(value.index(), [&](auto J)
+            {
+                this->template push_alternative<to_ours::value[J]>(*std::get_if<J>(&value));
+            });
+        }
+
+        // give the pool entry of the element at 'index', if it has one, back to its pool.
+        // We drop the value now so a big string doesn't hang around.
+
+        void release_slot(std::size_t index)
+        {
+            mp11::mp_with_index<sizeof...(Ts)>(tags_[index], [&](auto I)
+            {
+                using X = std::variant_alternative_t<I, value_type>;
+                if constexpr(! cpp_like_py::is_inline_alternative_v<X>)
+                {
+                    std::get<I>(pools_)[slots_[index]] = X{};
+                    free_[I].push_back(static_cast<std::uint32_t>(slots_[index]));
+                }
+            });
+        }
+
+        void assign_value(std::size_t index, value_type&& value)
+        {
+            if (index >= tags_.size())
+            {
+                throw std::out_of_range{"compact_py_vector index out of range"};
+            }
+
+            mp11::mp_with_index<sizeof...(Ts)>(value.index(), [&](auto I)
+            {
+                using X = std::variant_alternative_t<I, value_type>;
+                if constexpr(! cpp_like_py::is_inline_alternative_v<X>)
+                {
+                    if (tags_[index] == I)
+                    {
+                        // same pooled alternative is an in place update.
+
+                        std::get<I>(pools_)[slots_[index]] = std::move(*std::get_if<I>(&value));
+                        return;
+                    }
+                }
+                const auto slot = make_slot<I>(std::move(*std::get_if<I>(&value)));
+                release_slot(index);
+                tags_[index] = static_cast<tag_type>(I);
+                slots_[index] = slot;
+            });
+            compact_pools();
+        }
+
+        // rebuild any pool which is more than half free, in list order.
+
+        void compact_pools()
+        {
+            mp11::mp_for_each<mp11::mp_iota_c<sizeof...(Ts)>>([&](auto I)
+            {
+                using X = std::variant_alternative_t<I, value_type>;
+                if constexpr(! cpp_like_py::is_inline_alternative_v<X>)
+                {
+                    auto& pool = std::get<I>(pools_);
+                    auto& free = free_[I];
+                    if (free.size() < 64 || free.size() * 2 < pool.size())
+                    {
+                        return;
+                    }
+
+                    std::vector<X> new_pool;
+                    new_pool.reserve(pool.size() - free.size());
+                    for (std::size_t i = 0; i < tags_.size(); ++i)
+                    {
+                        if (tags_[i] == I)
+                        {
+                            new_pool.push_back(std::move(pool[slots_[i]]));
+                            slots_[i] = static_cast<slot_type>(new_pool.size() - 1);
+                        }
+                    }
+                    pool = std::move(new_pool);
+                    free.clear();
+                }
+            });
+        }
+
+        /* ====================  DATA MEMBERS  ======================================= */
+
+        std::vector<tag_type> tags_;
+        std::vector<slot_type> slots_;
+        pools_t pools_;
+        std::array<std::vector<std::uint32_t>, sizeof...(Ts)> free_;
+
+}; /* ----------  end of template class compact_py_vector  ---------- */
+
+#endif   /* ----- #ifndef _COMPACT_PY_VECTOR_INC_  ----- */
@@ -0,0 +1,401 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  concurrent_py_vector.h
+ *
+ *    Description:  list which many threads can append to at once without locking.
+ *                  Elements never move once they are in so readers don't need a
+ *                  lock either.
+ *
+ *        Version:  1.0
+ *        Created:  10/18/2026 11:02:48 AM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  David P. Riedel (), driedel@cox.net
+ *   Organization:
+ *
+ * =====================================================================================
+ */
+
+
+#ifndef  _CONCURRENT_PY_VECTOR_INC_
+#define  _CONCURRENT_PY_VECTOR_INC_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <variant>
+
+#include "py_vector.h"
+
+/*
+ * =====================================================================================
+ *        Class:  concurrent_py_vector
+ *  Description:  provides a Python-like list class for C++ which any number of
+ *                threads can append to at the same time.
+ * =====================================================================================
+ */
+
+// The elements live in segments which double in size: the first holds 1024 elements,
+// then 1024, 2048, 4096...  A segment is allocated the first time somebody needs it
+// and never moves or shrinks, so a reference to an element is good until the list
+// is destroyed.
+//
+// append takes the next index with one fetch_add, builds the element in its slot and
+// then marks the slot published.  Nothing else is shared between producers.  Reading a
+// published element is a couple of shifts and 2 loads.
+//
+// freeze() gives a py_vector_view of everything appended so far.  The view works with
+// print_list, contains, count, visit_all, etc. and later appends don't disturb it.
+// to_py_vector() makes an ordinary py_vector.
+//
+//      concurrent_py_vector<int, std::string> received;
+//      ...on any number of threads
+//      received.append(42);
+//      ...once they are done
+//      received.freeze().print_list(std::cout);
+
+template<typename ...Ts>
+class concurrent_py_vector
+{
+    public:
+
+        using value_type = std::variant<Ts...>;
+
+        static_assert(std::is_nothrow_move_constructible_v<value_type>,
+                "concurrent_py_vector moves new elements into place so they must have a noexcept move constructor.");
+
+        // iterates over the first 'count' elements, which must all be published.
+
+        class const_iterator
+        {
+            public:
+
+                using iterator_category = std::random_access_iterator_tag;
+                using value_type = concurrent_py_vector::value_type;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const value_type*;
+                using reference = const value_type&;
+
+                const_iterator() = default;
+                const_iterator(const concurrent_py_vector* list, std::ptrdiff_t pos) : list_{list}, pos_{pos} { }
+
+                reference operator*() const { return (*list_)[static_cast<std::size_t>(pos_)]; }
+                pointer operator->() const { return &**this; }
+                reference operator[](difference_type n) const { return (*list_)[static_cast<std::size_t>(pos_ + n)]; }
+
+                const_iterator& operator++() { ++pos_; return *this; }
+                const_iterator operator++(int) { auto result{*this}; ++pos_; return result; }
+                const_iterator& operator--() { --pos_; return *this; }
+                const_iterator operator--(int) { auto result{*this}; --pos_; return result; }
+                const_iterator& operator+=(difference_type n) { pos_ += n; return *this; }
+                const_iterator& operator-=(difference_type n) { pos_ -= n; return *this; }
+                const_iterator operator+(difference_type n) const { return const_iterator{list_, pos_ + n}; }
+                const_iterator operator-(difference_type n) const { return const_iterator{list_, pos_ - n}; }
+                difference_type operator-(const const_iterator& rhs) const { return pos_ - rhs.pos_; }
+
+                bool operator==(const const_iterator& rhs) const { return pos_ == rhs.pos_; }
+                bool operator!=(const const_iterator& rhs) const { return pos_ != rhs.pos_; }
+                bool operator<(const const_iterator& rhs) const { return pos_ < rhs.pos_; }
+                bool operator>(const const_iterator& rhs) const { return pos_ > rhs.pos_; }
+                bool operator<=(const const_iterator& rhs) const { return pos_ <= rhs.pos_; }
+                bool operator>=(const const_iterator& rhs) const { return pos_ >= rhs.pos_; }
+
+            private:
+
+                const concurrent_py_vector* list_ = nullptr;
+                std::ptrdiff_t pos_ = 0;
+        };
+
+        /* ====================  LIFECYCLE     ======================================= */
+        concurrent_py_vector () = default;                                  /* constructor */
+
+        ~concurrent_py_vector ()
+        {
+            const std::size_t count = reserved_.load(std::memory_order_acquire);
+            for (std::size_t k = 0; k < segment_slots; ++k)
+            {
+                segment* seg = segments_[k].load(std::memory_order_acquire);
+                if (seg == nullptr)
+                {
+                    continue;
+                }
+                const std::size_t first = segment_start(k);
+                for (std::size_t i = 0; i < seg->size && first + i < count; ++i)
+                {
+                    if (seg->states[i].load(std::memory_order_acquire) == published)
+                    {
+                        std::destroy_at(seg->values + i);
+                    }
+                }
+                delete seg;
+            }
+        }
+
+        // elements are never moved so neither are we.
+
+        concurrent_py_vector (const concurrent_py_vector&) = delete;
+        concurrent_py_vector& operator= (const concurrent_py_vector&) = delete;
+
+        /* ====================  ACCESSORS     ======================================= */
+
+        // how many appends have started.  Elements past the published ones may still
+        // be on their way in.
+
+        std::size_t size() const { return reserved_.load(std::memory_order_acquire); }
+        bool empty() const { return size() == 0; }
+
+        bool is_published(std::size_t index) const
+        {
+            if (index >= size())
+            {
+                return false;
+            }
+            const auto [k, offset] = locate(index);
+            const segment* seg = segments_[k].load(std::memory_order_acquire);
+            return seg != nullptr && seg->states[offset].load(std::memory_order_acquire) == published;
+        }
+
+        // 'index' must be published: returned by an append which has finished or
+        // checked with is_published().  Wait free.
+
+        const value_type& operator[](std::size_t index) const
+        {
+            const auto [k, offset] = locate(index);
+            return segments_[k].load(std::memory_order_acquire)->values[offset];
+        }
+
+        const value_type& at(std::size_t index) const
+        {
+            if (! is_published(index))
+            {
+                throw std::out_of_range{"concurrent_py_vector: index is not published."};
+            }
+            return (*this)[index];
+        }
+
+        // a read-only view of everything appended before the call.  Waits for appends
+        // which have taken their index but not finished.  The view stays good while
+        // other threads go on appending, they just aren't in it.
+
+        py_vector_view<const_iterator> freeze() const
+        {
+            const std::size_t count = reserved_.load(std::memory_order_acquire);
+
+            // every slot below frozen_ has already been waited for.
+
+            std::size_t i = frozen_.load(std::memory_order_acquire);
+            for (; i < count; ++i)
+            {
+                const auto [k, offset] = locate(i);
+                const segment* seg = segments_[k].load(std::memory_order_acquire);
+                while (seg == nullptr || seg->states[offset].load(std::memory_order_acquire) != published)
+                {
+                    // an append which failed after taking its index never publishes it.
+
+                    if (failed_appends_.load(std::memory_order_acquire) != 0)
+                    {
+                        throw std::runtime_error{"concurrent_py_vector: an append failed part way so the list has a hole in it."};
+                    }
+                    std::this_thread::yield();
+                    seg = segments_[k].load(std::memory_order_acquire);
+                }
+            }
+
+            std::size_t old_frozen = frozen_.load(std::memory_order_relaxed);
+            while (old_frozen < count && ! frozen_.compare_exchange_weak(old_frozen, count, std::memory_order_acq_rel))
+            {
+            }
+            return {const_iterator{this, 0}, 1, count};
+        }
+
+        [[nodiscard]] py_vector<Ts...> to_py_vector() const
+        {
+            return py_vector<Ts...>{freeze()};
+        }
+
+        /* ====================  MUTATORS      ======================================= */
+
+        // these can all be called from any number of threads at once.  They give back
+        // the index of the (first) new element.
+
+        template<typename T, typename = std::enable_if_t<! std::is_same_v<std::decay_t<T>, concurrent_py_vector>>>
+        std::size_t append(T&& element)
+        {
+            return emplace<std::decay_t<T>>(std::forward<T>(element));
+        }
+
+        template<typename T>
+        concurrent_py_vector& operator+=(T&& element)
+        {
+            append(std::forward<T>(element));
+            return *this;
+        }
+
+        // the element is built before it gets an index so if building it throws, no harm
+        // is done.
+
+        template<typename T, typename ...Args>
+        std::size_t emplace(Args&& ...args)
+        {
+            static_assert(mp11::mp_contains<mp11::mp_list<Ts...>, T>::value, "Type T must be in type signature of py_vector.");
+
+            value_type new_value{std::in_place_index<mp11::mp_find<mp11::mp_list<Ts...>, T>::value>, std::forward<Args>(args)...};
+            const std::size_t index = reserved_.fetch_add(1, std::memory_order_relaxed);
+            try
+            {
+                place(index, std::move(new_value));
+            }
+            catch (...)
+            {
+                failed_appends_.fetch_add(1, std::memory_order_release);
+                throw;
+            }
+            return index;
+        }
+
+        // a run of elements with neighbouring indexes, for only 1 trip to the shared
+        // counter.  The elements can be variants we can hold or plain values of a type in
+        // our type signature.
+
+        template<typename Iterator>
+        std::size_t extend(Iterator first, Iterator last)
+        {
+            using source_t = typename std::iterator_traits<Iterator>::value_type;
+
+            const auto count = static_cast<std::size_t>(std::distance(first, last));
+            const std::size_t start = reserved_.fetch_add(count, std::memory_order_relaxed);
+            try
+            {
+                for (std::size_t index = start; first != last; ++first, ++index)
+                {
+                    if constexpr(cpp_like_py::is_variant_v<source_t>)
+                    {
+                        place(index, std::visit([](const auto& x) { return make_value(x); }, *first));
+                    }
+                    else
+                    {
+                        place(index, make_value(*first));
+                    }
+                }
+            }
+            catch (...)
+            {
+                failed_appends_.fetch_add(1, std::memory_order_release);
+                throw;
+            }
+            return start;
+        }
+
+        // allocates the segments for the first 'count' elements now rather than as they
+        // are needed.
+
+        void reserve(std::size_t count)
+        {
+            if (count != 0)
+            {
+                const std::size_t last_segment = locate(count - 1).first;
+                for (std::size_t k = 0; k <= last_segment; ++k)
+                {
+                    segment_for(k);
+                }
+            }
+        }
+
+    private:
+
+        static constexpr std::uint8_t published = 1;
+
+        struct segment
+        {
+            explicit segment(std::size_t n)
+                : size{n}, values{std::allocator<value_type>{}.allocate(n)}, states{new std::atomic<std::uint8_t>[n]()} { }
+
+            ~segment()
+            {
+                std::allocator<value_type>{}.deallocate(values, size);
+            }
+
+            const std::size_t size;
+            value_type* const values;
+            const std::unique_ptr<std::atomic<std::uint8_t>[]> states;
+        };
+
+        static constexpr std::size_t first_segment_bits = 10;
+        static constexpr std::size_t first_segment_size = std::size_t{1} << first_segment_bits;
+        static constexpr std::size_t segment_slots = 64 - first_segment_bits + 1;
+
+        /* ====================  METHODS       ======================================= */
+
+        // segment k > 0 starts at 2^(first_segment_bits + k - 1) and is just as long.
+
+        static std::size_t segment_start(std::size_t k)
+        {
+            return k == 0 ? 0 : first_segment_size << (k - 1);
+        }
+
+        static std::pair<std::size_t, std::size_t> locate(std::size_t index)
+        {
+            if (index < first_segment_size)
+            {
+                return {0, index};
+            }
+            const std::size_t high_bit = 63 - static_cast<std::size_t>(__builtin_clzll(index));
+            return {high_bit - first_segment_bits + 1, index - (std::size_t{1} << high_bit)};
+        }
+
+        // whoever gets to a segment first allocates it.  If 2 threads race, the loser
+        // throws its copy away.
+
+        segment* segment_for(std::size_t k)
+        {
+            segment* seg = segments_[k].load(std::memory_order_acquire);
+            if (seg == nullptr)
+            {
+                auto new_segment = std::make_unique<segment>(k == 0 ? first_segment_size : segment_start(k));
+                if (segments_[k].compare_exchange_strong(seg, new_segment.get(), std::memory_order_acq_rel))
+                {
+                    seg = new_segment.release();
+                }
+            }
+            return seg;
+        }
+
+        // a plain value goes in the first alternative of its type.
+
+        template<typename X>
+        static value_type make_value(const X& x)
+        {
+            static_assert(mp11::mp_contains<mp11::mp_list<Ts...>, X>::value, "Type T must be in type signature of py_vector.");
+            return value_type{std::in_place_index<mp11::mp_find<mp11::mp_list<Ts...>, X>::value>, x};
+        }
+
+        // once an index is taken it can't be given back so if this throws, the caller
+        // counts a failed append and freeze() won't wait for it forever.
+
+        void place(std::size_t index, value_type&& new_value)
+        {
+            const auto [k, offset] = locate(index);
+            segment* seg = segment_for(k);
+            ::new (static_cast<void*>(seg->values + offset)) value_type(std::move(new_value));
+            seg->states[offset].store(published, std::memory_order_release);
+        }
+
+        /* ====================  DATA MEMBERS  ======================================= */
+
+        // the counter producers fight over gets a cache line of its own.
+
+        alignas(64) std::atomic<std::size_t> reserved_{0};
+        alignas(64) mutable std::atomic<std::size_t> frozen_{0};
+        std::atomic<std::size_t> failed_appends_{0};
+        std::array<std::atomic<segment*>, segment_slots> segments_{};
+
+}; /* ----------  end of template class concurrent_py_vector  ---------- */
+
+#endif   /* ----- #ifndef _CONCURRENT_PY_VECTOR_INC_  ----- */
@@ -0,0 +1,390 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  cow_py_vector.h
+ *
+ *    Description:  py_vector whose copies and slices share their elements until one
+ *                  of them changes.
+ *
+ *        Version:  1.0
+ *        Created:  10/18/2026 09:37:12 AM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  David P. Riedel (), driedel@cox.net
+ *   Organization:
+ *
+ * =====================================================================================
+ */
+
+
+#ifndef  _COW_PY_VECTOR_INC_
+#define  _COW_PY_VECTOR_INC_
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include "py_vector.h"
+
+namespace cpp_like_py
+{
+    /*
+     * =====================================================================================
+     *        Class:  cow_vector
+     *  Description:  vector-like container whose copies share one reference counted
+     *                buffer.  Copy on write.
+     * =====================================================================================
+     */
+
+    // just enough of the std::vector interface for basic_py_vector.  Iterators are plain
+    // pointers.
+    //
+    // A copy takes another reference to our buffer, share() gives a window onto part
+    // of it.  Anything which could change an element, including the non-const
+    // accessors, first makes sure we are the only one using the buffer and that we
+    // use all of it, copying our window into a buffer of our own if not.
+    //
+    // Several threads can read lists which share a buffer, and change their own list,
+    // at the same time.  As with std::vector, one list still can't be changed by one
+    // thread while another is looking at it.
+
+    template<typename T>
+    class cow_vector
+    {
+        public:
+
+            using value_type = T;
+            using size_type = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using reference = T&;
+            using const_reference = const T&;
+            using pointer = T*;
+            using const_pointer = const T*;
+            using iterator = T*;
+            using const_iterator = const T*;
+
+            /* ====================  LIFECYCLE     ======================================= */
+            cow_vector () noexcept = default;                                   /* constructor */
+
+            ~cow_vector ()
+            {
+                release();
+            }
+
+            cow_vector (std::initializer_list<T> values) : block_{new block{values}}, size_{values.size()} { }
+
+            cow_vector (const cow_vector& rhs) noexcept : block_{rhs.block_}, offset_{rhs.offset_}, size_{rhs.size_}
+            {
+                if (block_ != nullptr)
+                {
+                    block_->refs.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+
+            cow_vector (cow_vector&& rhs) noexcept
+                : block_{std::exchange(rhs.block_, nullptr)}, offset_{std::exchange(rhs.offset_, 0)},
+                size_{std::exchange(rhs.size_, 0)} { }
+
+            /* ====================  ACCESSORS     ======================================= */
+
+            size_type size() const noexcept { return size_; }
+            bool empty() const noexcept { return size_ == 0; }
+
+            // how many elements we can hold before we have to allocate, counting a shared
+            // buffer as full since changing it means making our own.
+
+            size_type capacity() const noexcept
+            {
+                return block_ == nullptr ? 0 : is_sole_owner() ? block_->values.capacity() - offset_ : size_;
+            }
+
+            // how many lists are using our buffer, us included.
+
+            size_type use_count() const noexcept
+            {
+                return block_ == nullptr ? 0 : block_->refs.load(std::memory_order_acquire);
+            }
+
+            const T* data() const noexcept { return block_ == nullptr ? nullptr : block_->values.data() + offset_; }
+            const_iterator begin() const noexcept { return data(); }
+            const_iterator cbegin() const noexcept { return data(); }
+            const_iterator end() const noexcept { return data() + size_; }
+            const_iterator cend() const noexcept { return data() + size_; }
+
+            const T& operator[](size_type index) const { return data()[index]; }
+            const T& front() const { return data()[0]; }
+            const T& back() const { return data()[size_ - 1]; }
+
+            // the non-const versions hand out references we could be written through.
+
+            T* data()
+            {
+                if (block_ == nullptr)
+                {
+                    return nullptr;
+                }
+                make_unique(size_);
+                return block_->values.data();
+            }
+
+            iterator begin() { return data(); }
+            iterator end() { return data() + size_; }
+
+            T& operator[](size_type index) { return data()[index]; }
+            T& front() { return data()[0]; }
+            T& back() { return data()[size_ - 1]; }
+
+            // 'count' elements from 'first' on, sharing our buffer.
+
+            cow_vector share(size_type first, size_type count) const noexcept
+            {
+                cow_vector result{*this};
+                result.offset_ += first;
+                result.size_ = count;
+                if (count == 0)
+                {
+                    result.release();
+                }
+                return result;
+            }
+
+            /* ====================  MUTATORS      ======================================= */
+
+            void reserve(size_type new_capacity)
+            {
+                if (new_capacity > capacity())
+                {
+                    make_unique(new_capacity);
+                    block_->values.reserve(new_capacity);
+                }
+            }
+
+            void clear() noexcept
+            {
+                if (is_sole_owner() && offset_ == 0)
+                {
+                    // keep the buffer for the next time we fill up.
+
+                    block_->values.clear();
+                    size_ = 0;
+                }
+                else
+                {
+                    release();
+                }
+            }
+
+            template<typename ...Args>
+            T& emplace_back(Args&& ...args)
+            {
+                if (block_ == nullptr)
+                {
+                    make_unique(1);
+                }
+                else if (! is_whole_and_unique())
+                {
+                    // the arguments may refer to one of our elements so build the new
+                    // element before we let go of the old buffer.
+
+                    T new_value(std::forward<Args>(args)...);
+                    make_unique(size_ + 1);
+                    return push(std::move(new_value));
+                }
+                return push(std::forward<Args>(args)...);
+            }
+
+            void push_back(const T& value) { emplace_back(value); }
+            void push_back(T&& value) { emplace_back(std::move(value)); }
+
+            void pop_back()
+            {
+                make_unique(size_);
+                block_->values.pop_back();
+                --size_;
+            }
+
+            template<typename ...Args>
+            iterator emplace(const_iterator pos, Args&& ...args)
+            {
+                const size_type where = pos - cbegin();
+                T new_value(std::forward<Args>(args)...);
+                make_unique(size_ + 1);
+                block_->values.insert(block_->values.begin() + where, std::move(new_value));
+                ++size_;
+                return block_->values.data() + where;
+            }
+
+            iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+            iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+            iterator erase(const_iterator first, const_iterator last)
+            {
+                const size_type from = first - cbegin();
+                const size_type to = last - cbegin();
+                if (from == to)
+                {
+                    return begin() + from;
+                }
+                if (! is_whole_and_unique())
+                {
+                    // copy what's left rather than copying everything then erasing.
+
+                    block* new_block = new block{};
+                    new_block->values.reserve(size_ - (to - from));
+                    new_block->values.insert(new_block->values.end(), cbegin(), cbegin() + from);
+                    new_block->values.insert(new_block->values.end(), cbegin() + to, cend());
+                    adopt(new_block);
+                }
+                else
+                {
+                    block_->values.erase(block_->values.begin() + from, block_->values.begin() + to);
+                    size_ = block_->values.size();
+                }
+                return block_->values.data() + from;
+            }
+
+            iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+            /* ====================  OPERATORS     ======================================= */
+
+            cow_vector& operator=(const cow_vector& rhs) noexcept
+            {
+                if (this != &rhs)
+                {
+                    cow_vector new_values{rhs};
+                    *this = std::move(new_values);
+                }
+                return *this;
+            }
+
+            cow_vector& operator=(cow_vector&& rhs) noexcept
+            {
+                if (this != &rhs)
+                {
+                    release();
+                    block_ = std::exchange(rhs.block_, nullptr);
+                    offset_ = std::exchange(rhs.offset_, 0);
+                    size_ = std::exchange(rhs.size_, 0);
+                }
+                return *this;
+            }
+
+            bool operator==(const cow_vector& rhs) const
+            {
+                if (size_ != rhs.size_)
+                {
+                    return false;
+                }
+                return cbegin() == rhs.cbegin() || std::equal(cbegin(), cend(), rhs.cbegin());
+            }
+
+            bool operator!=(const cow_vector& rhs) const { return ! (*this == rhs); }
+
+        private:
+
+            struct block
+            {
+                std::vector<T> values;
+                std::atomic<size_type> refs{1};
+            };
+
+            /* ====================  METHODS       ======================================= */
+
+            // the acquire pairs with the release in release() so anything another list
+            // did with the buffer before letting go of it is done before we change it.
+
+            bool is_sole_owner() const noexcept
+            {
+                return block_ != nullptr && block_->refs.load(std::memory_order_acquire) == 1;
+            }
+
+            bool is_whole_and_unique() const noexcept
+            {
+                return is_sole_owner() && offset_ == 0 && size_ == block_->values.size();
+            }
+
+            // after this we own all of our buffer, which has room for at least
+            // 'min_capacity' elements.
+
+            void make_unique(size_type min_capacity)
+            {
+                if (block_ == nullptr)
+                {
+                    block_ = new block{};
+                    block_->values.reserve(min_capacity);
+                    return;
+                }
+                if (is_whole_and_unique())
+                {
+                    return;
+                }
+                if (is_sole_owner())
+                {
+                    // a window onto a buffer nobody else wants any more.  Trim it.
+
+                    auto& values = block_->values;
+                    values.erase(values.begin() + offset_ + size_, values.end());
+                    values.erase(values.begin(), values.begin() + offset_);
+                    offset_ = 0;
+                    return;
+                }
+
+                block* new_block = new block{};
+                new_block->values.reserve(std::max(min_capacity, size_));
+                new_block->values.assign(cbegin(), cend());
+                adopt(new_block);
+            }
+
+            void adopt(block* new_block) noexcept
+            {
+                release();
+                block_ = new_block;
+                size_ = new_block->values.size();
+            }
+
+            template<typename ...Args>
+            T& push(Args&& ...args)
+            {
+                T& result = block_->values.emplace_back(std::forward<Args>(args)...);
+                ++size_;
+                return result;
+            }
+
+            void release() noexcept
+            {
+                if (block_ != nullptr && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    delete block_;
+                }
+                block_ = nullptr;
+                offset_ = 0;
+                size_ = 0;
+            }
+
+            /* ====================  DATA MEMBERS  ======================================= */
+
+            block* block_ = nullptr;
+            size_type offset_ = 0;
+            size_type size_ = 0;
+
+    }; /* ----------  end of template class cow_vector  ---------- */
+}		/* -----  end of namespace cpp_like_py  ----- */
+
+// storage policy for basic_py_vector whose copies and slices share their elements.
+
+struct cow_storage
+{
+    template<typename V>
+        using container_t = cpp_like_py::cow_vector<V>;
+};
+
+// cow_py_vector<int, std::string> x{1, "ab"}; auto y = x; costs a reference count bump.
+// So does x.slice(a, b).  The first change to either one, through operator[], append,
+// erase, visit_all, etc., gives it its own copy.
+
+template<typename ...Ts>
+        using cow_py_vector = basic_py_vector<cow_storage, Ts...>;
+
+#endif   /* ----- #ifndef _COW_PY_VECTOR_INC_  ----- */
@@ -0,0 +1,372 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  gap_py_vector.h
+ *
+ *    Description:  py_vector kept in a gap buffer so inserting and erasing at or near
+ *                  the last place we edited doesn't move the rest of the list.
+ *
+ *        Version:  1.0
+ *        Created:  10/18/2026 01:24:19 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  David P. Riedel (), driedel@cox.net
+ *   Organization:
+ *
+ * =====================================================================================
+ */
+
+
+#ifndef  _GAP_PY_VECTOR_INC_
+#define  _GAP_PY_VECTOR_INC_
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+#include "py_vector.h"
+
+namespace cpp_like_py
+{
+    /*
+     * =====================================================================================
+     *        Class:  gap_vector
+     *  Description:  vector-like container with a movable hole in it.
+     * =====================================================================================
+     */
+
+    // just enough of the std::vector interface for basic_py_vector.
+    //
+    // The elements are in one array with a gap of unused slots somewhere in it.  An
+    // insert moves the gap to where it is going then fills in its first slot, an erase
+    // moves the gap there and widens it.  Moving the gap only moves the elements between
+    // where it was and where it goes so a run of edits in the same part of the list,
+    // the front say, costs O(1) each after the first.  Appending leaves the gap at the
+    // end so it is as cheap as std::vector's.
+    //
+    // Indexing is one compare against the start of the gap.  Iterators hold an index,
+    // not a pointer, since the elements aren't contiguous.
+
+    template<typename T>
+    class gap_vector
+    {
+        static_assert(std::is_nothrow_move_constructible_v<T>, "gap_vector moves elements across the gap so they must have a noexcept move constructor.");
+
+        public:
+
+            using value_type = T;
+            using size_type = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using reference = T&;
+            using const_reference = const T&;
+            using pointer = T*;
+            using const_pointer = const T*;
+
+            template<bool Const>
+            class basic_iterator
+            {
+                public:
+
+                    using iterator_category = std::random_access_iterator_tag;
+                    using value_type = T;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = std::conditional_t<Const, const T*, T*>;
+                    using reference = std::conditional_t<Const, const T&, T&>;
+                    using vector_t = std::conditional_t<Const, const gap_vector, gap_vector>;
+
+                    basic_iterator() = default;
+                    basic_iterator(vector_t* vector, difference_type pos) : vector_{vector}, pos_{pos} { }
+
+                    // an iterator converts to a const_iterator.
+
+                    template<bool C = Const, typename = std::enable_if_t<C>>
+                    basic_iterator(const basic_iterator<false>& rhs) : vector_{rhs.vector_}, pos_{rhs.pos_} { }
+
+                    reference operator*() const { return (*vector_)[static_cast<size_type>(pos_)]; }
+                    pointer operator->() const { return &**this; }
+                    reference operator[](difference_type n) const { return (*vector_)[static_cast<size_type>(pos_ + n)]; }
+
+                    basic_iterator& operator++() { ++pos_; return *this; }
+                    basic_iterator operator++(int) { auto result{*this}; ++pos_; return result; }
+                    basic_iterator& operator--() { --pos_; return *this; }
+                    basic_iterator operator--(int) { auto result{*this}; --pos_; return result; }
+                    basic_iterator& operator+=(difference_type n) { pos_ += n; return *this; }
+                    basic_iterator& operator-=(difference_type n) { pos_ -= n; return *this; }
+                    basic_iterator operator+(difference_type n) const { return basic_iterator{vector_, pos_ + n}; }
+                    basic_iterator operator-(difference_type n) const { return basic_iterator{vector_, pos_ - n}; }
+                    friend basic_iterator operator+(difference_type n, const basic_iterator& it) { return it + n; }
+                    difference_type operator-(const basic_iterator& rhs) const { return pos_ - rhs.pos_; }
+
+                    bool operator==(const basic_iterator& rhs) const { return pos_ == rhs.pos_; }
+                    bool operator!=(const basic_iterator& rhs) const { return pos_ != rhs.pos_; }
+                    bool operator<(const basic_iterator& rhs) const { return pos_ < rhs.pos_; }
+                    bool operator>(const basic_iterator& rhs) const { return pos_ > rhs.pos_; }
+                    bool operator<=(const basic_iterator& rhs) const { return pos_ <= rhs.pos_; }
+                    bool operator>=(const basic_iterator& rhs) const { return pos_ >= rhs.pos_; }
+
+                    difference_type position() const { return pos_; }
+
+                private:
+
+                    template<bool> friend class basic_iterator;
+
+                    vector_t* vector_ = nullptr;
+                    difference_type pos_ = 0;
+            };
+
+            using iterator = basic_iterator<false>;
+            using const_iterator = basic_iterator<true>;
+
+            /* ====================  LIFECYCLE     ======================================= */
+            gap_vector () noexcept = default;                                   /* constructor */
+
+            ~gap_vector ()
+            {
+                clear();
+                std::allocator<T>{}.deallocate(data_, capacity_);
+            }
+
+            gap_vector (std::initializer_list<T> values)
+            {
+                copy_in(values.begin(), values.end(), values.size());
+            }
+
+            gap_vector (const gap_vector& rhs)
+            {
+                copy_in(rhs.begin(), rhs.end(), rhs.size());
+            }
+
+            gap_vector (gap_vector&& rhs) noexcept
+                : data_{std::exchange(rhs.data_, nullptr)}, capacity_{std::exchange(rhs.capacity_, 0)},
+                gap_start_{std::exchange(rhs.gap_start_, 0)}, gap_end_{std::exchange(rhs.gap_end_, 0)} { }
+
+            /* ====================  ACCESSORS     ======================================= */
+
+            size_type size() const noexcept { return capacity_ - gap_size(); }
+            size_type capacity() const noexcept { return capacity_; }
+            bool empty() const noexcept { return size() == 0; }
+
+            iterator begin() noexcept { return {this, 0}; }
+            const_iterator begin() const noexcept { return {this, 0}; }
+            const_iterator cbegin() const noexcept { return {this, 0}; }
+            iterator end() noexcept { return {this, static_cast<difference_type>(size())}; }
+            const_iterator end() const noexcept { return {this, static_cast<difference_type>(size())}; }
+            const_iterator cend() const noexcept { return {this, static_cast<difference_type>(size())}; }
+
+            T& operator[](size_type index) { return data_[physical(index)]; }
+            const T& operator[](size_type index) const { return data_[physical(index)]; }
+
+            T& front() { return (*this)[0]; }
+            const T& front() const { return (*this)[0]; }
+            T& back() { return (*this)[size() - 1]; }
+            const T& back() const { return (*this)[size() - 1]; }
+
+            /* ====================  MUTATORS      ======================================= */
+
+            // the gap stays where it is, just wider.
+
+            void reserve(size_type new_capacity)
+            {
+                if (new_capacity > capacity_)
+                {
+                    relocate(new_capacity);
+                }
+            }
+
+            void clear() noexcept
+            {
+                std::destroy(data_, data_ + gap_start_);
+                std::destroy(data_ + gap_end_, data_ + capacity_);
+                gap_start_ = 0;
+                gap_end_ = capacity_;
+            }
+
+            template<typename ...Args>
+            T& emplace_back(Args&& ...args)
+            {
+                return *emplace(cend(), std::forward<Args>(args)...);
+            }
+
+            void push_back(const T& value) { emplace_back(value); }
+            void push_back(T&& value) { emplace_back(std::move(value)); }
+
+            void pop_back()
+            {
+                erase(cend() - 1);
+            }
+
+            template<typename ...Args>
+            iterator emplace(const_iterator pos, Args&& ...args)
+            {
+                const auto where = static_cast<size_type>(pos.position());
+                if (where == gap_start_ && gap_size() != 0)
+                {
+                    // nothing has to move so the arguments can't be left pointing
+                    // at an element which did.
+
+                    ::new (static_cast<void*>(data_ + gap_start_)) T(std::forward<Args>(args)...);
+                }
+                else
+                {
+                    T new_value(std::forward<Args>(args)...);
+                    if (gap_size() == 0)
+                    {
+                        relocate(std::max<size_type>(16, capacity_ * 2));
+                    }
+                    move_gap(where);
+                    ::new (static_cast<void*>(data_ + gap_start_)) T(std::move(new_value));
+                }
+                ++gap_start_;
+                return {this, static_cast<difference_type>(where)};
+            }
+
+            iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+            iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+            iterator erase(const_iterator first, const_iterator last)
+            {
+                const auto from = static_cast<size_type>(first.position());
+                const auto count = static_cast<size_type>(last.position() - first.position());
+                if (count != 0)
+                {
+                    move_gap(from);
+                    std::destroy(data_ + gap_end_, data_ + gap_end_ + count);
+                    gap_end_ += count;
+                }
+                return {this, static_cast<difference_type>(from)};
+            }
+
+            iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+            /* ====================  OPERATORS     ======================================= */
+
+            gap_vector& operator=(const gap_vector& rhs)
+            {
+                if (this != &rhs)
+                {
+                    gap_vector new_values{rhs};
+                    *this = std::move(new_values);
+                }
+                return *this;
+            }
+
+            gap_vector& operator=(gap_vector&& rhs) noexcept
+            {
+                if (this != &rhs)
+                {
+                    clear();
+                    std::allocator<T>{}.deallocate(data_, capacity_);
+                    data_ = std::exchange(rhs.data_, nullptr);
+                    capacity_ = std::exchange(rhs.capacity_, 0);
+                    gap_start_ = std::exchange(rhs.gap_start_, 0);
+                    gap_end_ = std::exchange(rhs.gap_end_, 0);
+                }
+                return *this;
+            }
+
+            bool operator==(const gap_vector& rhs) const
+            {
+                return size() == rhs.size() && std::equal(begin(), end(), rhs.begin());
+            }
+
+            bool operator!=(const gap_vector& rhs) const { return ! (*this == rhs); }
+
+        private:
+            /* ====================  METHODS       ======================================= */
+
+            size_type gap_size() const noexcept { return gap_end_ - gap_start_; }
+
+            size_type physical(size_type index) const noexcept
+            {
+                return index < gap_start_ ? index : index + gap_size();
+            }
+
+            // slide the gap so it starts at 'where', moving the elements in between across it
+            // one at a time.  The slot each one lands in is always part of the gap.
+
+            void move_gap(size_type where) noexcept
+            {
+                while (gap_start_ > where)
+                {
+                    --gap_start_;
+                    --gap_end_;
+                    ::new (static_cast<void*>(data_ + gap_end_)) T(std::move(data_[gap_start_]));
+                    std::destroy_at(data_ + gap_start_);
+                }
+                while (gap_start_ < where)
+                {
+                    ::new (static_cast<void*>(data_ + gap_start_)) T(std::move(data_[gap_end_]));
+                    std::destroy_at(data_ + gap_end_);
+                    ++gap_start_;
+                    ++gap_end_;
+                }
+            }
+
+            // for the constructors.  Our destructor won't run if a copy throws so we have
+            // to give the array back ourselves.
+
+            template<typename Iterator>
+            void copy_in(Iterator first, Iterator last, size_type count)
+            {
+                reserve(count);
+                try
+                {
+                    std::uninitialized_copy(first, last, data_);
+                }
+                catch (...)
+                {
+                    std::allocator<T>{}.deallocate(data_, capacity_);
+                    throw;
+                }
+                gap_start_ = count;
+            }
+
+            // a bigger array with the gap in the same place.
+
+            void relocate(size_type new_capacity)
+            {
+                T* new_data = std::allocator<T>{}.allocate(new_capacity);
+                const size_type tail = capacity_ - gap_end_;
+
+                std::uninitialized_move(data_, data_ + gap_start_, new_data);
+                std::uninitialized_move(data_ + gap_end_, data_ + capacity_, new_data + new_capacity - tail);
+                std::destroy(data_, data_ + gap_start_);
+                std::destroy(data_ + gap_end_, data_ + capacity_);
+
+                std::allocator<T>{}.deallocate(data_, capacity_);
+                data_ = new_data;
+                capacity_ = new_capacity;
+                gap_end_ = new_capacity - tail;
+            }
+
+            /* ====================  DATA MEMBERS  ======================================= */
+
+            T* data_ = nullptr;
+            size_type capacity_ = 0;
+
+            // the unused slots are [gap_start_, gap_end_).
+
+            size_type gap_start_ = 0;
+            size_type gap_end_ = 0;
+
+    }; /* ----------  end of template class gap_vector  ---------- */
+}		/* -----  end of namespace cpp_like_py  ----- */
+
+// storage policy for basic_py_vector which keeps its elements in a gap buffer.
+
+struct gap_storage
+{
+    template<typename V>
+        using container_t = cpp_like_py::gap_vector<V>;
+};
+
+// gap_py_vector<int, std::string> x; use it where a py_vector is edited at the front or in
+// the middle over and over: insert, emplace_at, pop(i) and erase.  Indexing, iteration,
+// slice, contains, visit_all, etc. all work the same as they do for py_vector.
+
+template<typename ...Ts>
+        using gap_py_vector = basic_py_vector<gap_storage, Ts...>;
+
+#endif   /* ----- #ifndef _GAP_PY_VECTOR_INC_  ----- */
@@ -0,0 +1,469 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  indexed_py_vector.h
+ *
+ *    Description:  py_vector with a per-type hash index so contains, index_of
+ *                  and count don't have to scan the whole list.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 01:37:05 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  David P. Riedel (), driedel@cox.net
+ *   Organization:
+ *
+ * =====================================================================================
+ */
+
+
+#ifndef  _INDEXED_PY_VECTOR_INC_
+#define  _INDEXED_PY_VECTOR_INC_
+
+#include <atomic>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+
+#include "py_vector.h"
+
+namespace cpp_like_py
+{
+    // we can only index the alternatives std::hash knows about.  The others are
+    // still found by scanning the list.
+
+    template<typename T>
+    inline constexpr bool is_hashable_v = std::is_default_constructible_v<std::hash<T>>;
+
+    // for each distinct value of an alternative we keep its positions in the list, in order.
+    // The first one answers index_of, the number of them answers count.
+
+    template<typename T>
+    using value_positions_t = std::conditional_t<is_hashable_v<T>,
+            std::unordered_map<T, std::vector<std::size_t>>, std::monostate>;
+}		/* -----  end of namespace cpp_like_py  ----- */
+
+/*
+ * =====================================================================================
+ *        Class:  indexed_py_vector
+ *  Description:  a py_vector plus a hash index per alternative in its type signature.
+ * =====================================================================================
+ */
+
+// The index is built the first time it is needed.  After that, appends and
+// assignments through operator[] keep it up to date.  Operations which move lots of
+// elements around (erase, assignment of a whole list, visit_all) just mark it out of
+// date and it gets rebuilt by the next query which needs it.
+//
+// Like the standard containers, any number of threads may query a list at once as
+// long as none changes it.  The first of them to need the index builds it while the
+// others wait.
+
+template<typename ...Ts>
+class indexed_py_vector
+{
+    public:
+
+        using value_type = typename py_vector<Ts...>::value_type;
+        using index_t = std::tuple<cpp_like_py::value_positions_t<Ts>...>;
+
+        // the non-const index operator hands out one of these so we can see
+        // assignments to elements and keep the index straight.
+
+        class reference
+        {
+            public:
+
+                reference(indexed_py_vector* owner, std::size_t pos) : owner_{owner}, pos_{pos} { }
+
+                template<typename T>
+                reference& operator=(T&& value)
+                {
+                    owner_->assign_value(pos_, value_type(std::forward<T>(value)));
+                    return *this;
+                }
+
+                reference& operator=(const reference& rhs)
+                {
+                    owner_->assign_value(pos_, static_cast<const value_type&>(rhs));
+                    return *this;
+                }
+
+                operator const value_type&() const { return owner_->list_[pos_]; }
+
+                std::size_t index() const { return owner_->list_[pos_].index(); }
+
+                bool operator==(const value_type& rhs) const { return owner_->list_[pos_] == rhs; }
+                bool operator!=(const value_type& rhs) const { return ! (*this == rhs); }
+
+            private:
+
+                indexed_py_vector* owner_;
+                std::size_t pos_;
+        };
+
+        /* ====================  LIFECYCLE     ======================================= */
+        indexed_py_vector () = default;                                      /* constructor */
+        ~indexed_py_vector () = default;
+
+        indexed_py_vector (std::initializer_list<value_type> values) : list_{values} { }
+
+        explicit indexed_py_vector (const py_vector<Ts...>& values) : list_{values} { }
+        explicit indexed_py_vector (py_vector<Ts...>&& values) : list_{std::move(values)} { }
+
+        template<typename ... Us>
+        explicit indexed_py_vector(const py_vector<Us...>& rhs) : list_{rhs} { }
+
+        indexed_py_vector(const indexed_py_vector& rhs) : list_{rhs.list_}
+        {
+            std::lock_guard<std::mutex> lock{rhs.index_mutex_};
+            if (rhs.index_valid_.load(std::memory_order_relaxed))
+            {
+                index_ = rhs.index_;
+                index_valid_.store(true, std::memory_order_relaxed);
+            }
+        }
+
+        indexed_py_vector(indexed_py_vector&& rhs) noexcept
+            : list_{std::move(rhs.list_)}, index_{std::move(rhs.index_)}, index_valid_{rhs.index_valid_.load(std::memory_order_relaxed)}
+        {
+            rhs.invalidate_index();
+        }
+
+        /* ====================  ACCESSORS     ======================================= */
+
+        auto size() const { return list_.size(); }
+        auto begin() const { return list_.begin(); }
+        auto cbegin() const { return list_.cbegin(); }
+        auto end() const { return list_.end(); }
+        auto cend() const { return list_.cend(); }
+        auto empty() const { return list_.empty(); }
+
+        // everything which only reads the list can be done on the list itself.
+
+        const py_vector<Ts...>& list() const { return list_; }
+
+        void print_list(std::ostream& out, const cpp_like_py::format_options& options = {}) const { list_.print_list(out, options); }
+        [[nodiscard]] std::string to_string(const cpp_like_py::format_options& options = {}) const { return list_.to_string(options); }
+
+        bool index_is_built() const { return index_valid_.load(std::memory_order_acquire); }
+
+        template<typename Y>
+        bool contains(const Y& item) const
+        {
+            return count(item) != 0;
+        }
+
+        template<typename Y>
+        std::optional<std::size_t> index_of(const Y& item) const
+        {
+            std::optional<std::size_t> result;
+            if (! look_up(item, [&result](const std::vector<std::size_t>& positions)
+                {
+                    if (! result || positions.front() < *result)
+                    {
+                        result = positions.front();
+                    }
+                }))
+            {
+                return list_.index_of(item);
+            }
+            return result;
+        }
+
+        template<typename Y>
+        std::size_t count(const Y& item) const
+        {
+            std::size_t result{0};
+            if (! look_up(item, [&result](const std::vector<std::size_t>& positions) { result += positions.size(); }))
+            {
+                return list_.count(item);
+            }
+            return result;
+        }
+
+        // since visit_all can change any element of type T, the index has to be rebuilt afterwards.
+
+        template<typename T, class F>
+        void visit_all(F& func)
+        {
+            list_.template visit_all<T>(func);
+            invalidate_index();
+        }
+
+        /* ====================  MUTATORS      ======================================= */
+
+        // normally the index is built the first time it is needed but it can be done up front.
+
+        void build_index() const
+        {
+            if (index_valid_.load(std::memory_order_acquire))
+            {
+                return;
+            }
+            std::lock_guard<std::mutex> lock{index_mutex_};
+            if (index_valid_.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+            clear_index();
+            for (std::size_t i = 0; i < list_.size(); ++i)
+            {
+                add_position(list_[i], i);
+            }
+            index_valid_.store(true, std::memory_order_release);
+        }
+
+        // empties the index, keeping the maps' buckets for when it is rebuilt.
+
+        void invalidate_index()
+        {
+            index_valid_.store(false, std::memory_order_relaxed);
+            clear_index();
+        }
+
+        indexed_py_vector& append(const py_vector<Ts...>& rhs)
+        {
+            const std::size_t old_size = list_.size();
+            list_.append(rhs);
+            add_positions_from(old_size);
+            return *this;
+        }
+
+        indexed_py_vector& append(const indexed_py_vector& rhs)
+        {
+            return append(rhs.list_);
+        }
+
+        indexed_py_vector& append(std::initializer_list<value_type> new_values)
+        {
+            const std::size_t old_size = list_.size();
+            list_.append(new_values);
+            add_positions_from(old_size);
+            return *this;
+        }
+
+        template<typename T>
+        indexed_py_vector& append(const T& element)
+        {
+            list_.append(element);
+            add_positions_from(list_.size() - 1);
+            return *this;
+        }
+
+        // half open range
+
+        indexed_py_vector& erase(std::size_t from, std::size_t to)
+        {
+            list_.erase(from, to);
+            invalidate_index();
+            return *this;
+        }
+
+        /* ====================  OPERATORS     ======================================= */
+
+        indexed_py_vector& operator=(const indexed_py_vector& rhs)
+        {
+            if (this != &rhs)
+            {
+                indexed_py_vector copy{rhs};
+                *this = std::move(copy);
+            }
+            return *this;
+        }
+
+        indexed_py_vector& operator=(indexed_py_vector&& rhs) noexcept
+        {
+            list_ = std::move(rhs.list_);
+            index_ = std::move(rhs.index_);
+            index_valid_.store(rhs.index_valid_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            rhs.invalidate_index();
+            return *this;
+        }
+
+        template<typename ... Us>
+        indexed_py_vector& operator=(const py_vector<Us...>& rhs)
+        {
+            list_ = rhs;
+            invalidate_index();
+            return *this;
+        }
+
+        indexed_py_vector& operator+=(const indexed_py_vector& rhs)
+        {
+            return append(rhs);
+        }
+
+        indexed_py_vector& operator+=(const py_vector<Ts...>& rhs)
+        {
+            return append(rhs);
+        }
+
+        template<typename T>
+        indexed_py_vector& operator+=(const T& element)
+        {
+            return append(element);
+        }
+
+        reference operator[](std::size_t index)
+        {
+            return reference{this, index};
+        }
+
+        const value_type& operator[](std::size_t index) const
+        {
+            return list_[index];
+        }
+
+        bool operator==(const indexed_py_vector& rhs) const
+        {
+            return list_ == rhs.list_;
+        }
+
+        template<typename ... Us>
+        bool operator==(const py_vector<Us...>& rhs) const
+        {
+            return list_ == rhs;
+        }
+
+    protected:
+        /* ====================  METHODS       ======================================= */
+
+        /* ====================  DATA MEMBERS  ======================================= */
+
+    private:
+        /* ====================  METHODS       ======================================= */
+
+        // calls 'found' with the positions of 'item' in each indexed alternative of type Y.
+        // returns false if some alternative of type Y can't be indexed so the caller
+        // needs to scan the list instead.
+
+        template<typename Y, typename F>
+        bool look_up(const Y& item, F&& found) const
+        {
+            bool indexed{true};
+            mp11::mp_for_each<mp11::mp_iota_c<sizeof...(Ts)>>([&](auto I)
+            {
+                using X = std::variant_alternative_t<I, value_type>;
+                if constexpr(std::is_same_v<X, Y>)
+                {
+                    if constexpr(cpp_like_py::is_hashable_v<X>)
+                    {
+                        build_index();
+                        const auto& positions = std::get<I>(index_);
+                        if (auto where = positions.find(item); where != positions.end())
+                        {
+                            found(where->second);
+                        }
+                    }
+                    else
+                    {
+                        indexed = false;
+                    }
+                }
+            });
+            return indexed;
+        }
+
+        void clear_index() const
+        {
+            mp11::mp_for_each<mp11::mp_iota_c<sizeof...(Ts)>>([this](auto I)
+            {
+                if constexpr(cpp_like_py::is_hashable_v<std::variant_alternative_t<I, value_type>>)
+                {
+                    std::get<I>(index_).clear();
+                }
+            });
+        }
+
+        void add_position(const value_type& elem, std::size_t pos) const
+        {
+            mp11::mp_with_index<sizeof...(Ts)>(elem.index(), [&](auto I)
+            {
+                using X = std::variant_alternative_t<I, value_type>;
+                if constexpr(cpp_like_py::is_hashable_v<X>)
+                {
+                    // positions only ever get added at the end of the list so this stays sorted.
+
+                    std::get<I>(index_)[std::get<I>(elem)].push_back(pos);
+                }
+            });
+        }
+
+        void add_positions_from(std::size_t first) const
+        {
+            if (index_valid_.load(std::memory_order_relaxed))
+            {
+                for (std::size_t i = first; i < list_.size(); ++i)
+                {
+                    add_position(list_[i], i);
+                }
+            }
+        }
+
+        void remove_position(const value_type& elem, std::size_t pos) const
+        {
+            mp11::mp_with_index<sizeof...(Ts)>(elem.index(), [&](auto I)
+            {
+                using X = std::variant_alternative_t<I, value_type>;
+                if constexpr(cpp_like_py::is_hashable_v<X>)
+                {
+                    auto& positions = std::get<I>(index_);
+                    auto where = positions.find(std::get<I>(elem));
+                    auto& these = where->second;
+                    these.erase(std::lower_bound(these.begin(), these.end(), pos));
+                    if (these.empty())
+                    {
+                        positions.erase(where);
+                    }
+                }
+            });
+        }
+
+        void insert_position(const value_type& elem, std::size_t pos) const
+        {
+            mp11::mp_with_index<sizeof...(Ts)>(elem.index(), [&](auto I)
+            {
+                using X = std::variant_alternative_t<I, value_type>;
+                if constexpr(cpp_like_py::is_hashable_v<X>)
+                {
+                    auto& these = std::get<I>(index_)[std::get<I>(elem)];
+                    these.insert(std::lower_bound(these.begin(), these.end(), pos), pos);
+                }
+            });
+        }
+
+        void assign_value(std::size_t pos, value_type&& value)
+        {
+            if (index_valid_.load(std::memory_order_relaxed))
+            {
+                remove_position(list_[pos], pos);
+                list_[pos] = std::move(value);
+                insert_position(list_[pos], pos);
+            }
+            else
+            {
+                list_[pos] = std::move(value);
+            }
+        }
+
+        void assign_value(std::size_t pos, const value_type& value)
+        {
+            assign_value(pos, value_type{value});
+        }
+
+        /* ====================  DATA MEMBERS  ======================================= */
+
+        py_vector<Ts...> list_;
+
+        // queries build the index under the mutex.  Changes to the list, which may not
+        // overlap with anything else, don't need it.
+
+        mutable index_t index_;
+        mutable std::atomic<bool> index_valid_{false};
+        mutable std::mutex index_mutex_;
+
+}; /* ----------  end of template class indexed_py_vector  ---------- */
+
+#endif   /* ----- #ifndef _INDEXED_PY_VECTOR_INC_  ----- */
@@ -0,0 +1,473 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  nested_py_vector.h
+ *
+ *    Description:  lists of lists, like Python's, with every list in the tree kept in
+ *                  one pool owned by the tree.
+ *
+ *        Version:  1.0
+ *        Created:  10/19/2026 04:26:13 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  David P. Riedel (), driedel@cox.net
+ *   Organization:
+ *
+ * =====================================================================================
+ */
+
+
+#ifndef  _NESTED_PY_VECTOR_INC_
+#define  _NESTED_PY_VECTOR_INC_
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "py_vector.h"
+
+namespace cpp_like_py
+{
+    // an element which is a list.  It holds the position of that list in its tree's
+    // pool so it only means something inside the tree.  Printed on its own, outside its
+    // tree, it looks like Python's [...].
+
+    struct py_sublist
+    {
+        std::uint32_t node = 0;
+
+        bool operator==(const py_sublist& rhs) const { return node == rhs.node; }
+        bool operator!=(const py_sublist& rhs) const { return node != rhs.node; }
+        bool operator<(const py_sublist& rhs) const { return node < rhs.node; }
+    };
+
+    inline std::ostream& operator<<(std::ostream& out, const py_sublist&)
+    {
+        return out << "[...]";
+    }
+}		/* -----  end of namespace cpp_like_py  ----- */
+
+/*
+ * =====================================================================================
+ *        Class:  nested_py_vector
+ *  Description:  a tree of py_vectors.  Each list's elements are Ts... or another list.
+ * =====================================================================================
+ */
+
+// Every list in the tree, the top one included, is a py_vector<Ts..., py_sublist> in one
+// pool, a std::vector, owned by the tree.  A nested list is just its pool position so
+// adding one doesn't allocate a wrapper and copying the whole tree is copying the pool.
+// Lists erased from the tree go on a free list to be used again.
+//
+// Comparing, printing and copying part of a tree go through it with a stack of their
+// own, not the call stack, so however deep it is they can't run out of stack.
+//
+// Lists are got at through list_ref, a tree and a pool position, which stays good as
+// the tree grows.  References to elements and to elements() don't: adding a list to
+// the tree can move the pool.
+
+template<typename ...Ts>
+class nested_py_vector
+{
+    public:
+
+        using node_list = py_vector<Ts..., cpp_like_py::py_sublist>;
+        using value_type = typename node_list::value_type;
+
+        template<bool Const>
+        class basic_list_ref
+        {
+            public:
+
+                using tree_t = std::conditional_t<Const, const nested_py_vector, nested_py_vector>;
+                using list_t = std::conditional_t<Const, const node_list, node_list>;
+
+                basic_list_ref(tree_t* tree, std::uint32_t node) : tree_{tree}, node_{node} { }
+
+                // a list_ref converts to a const_list_ref.
+
+                template<bool C = Const, typename = std::enable_if_t<C>>
+                basic_list_ref(const basic_list_ref<false>& rhs) : tree_{rhs.tree_}, node_{rhs.node_} { }
+
+                /* ====================  ACCESSORS     ======================================= */
+
+                std::size_t size() const { return elements().size(); }
+                bool empty() const { return elements().size() == 0; }
+
+                // the list itself, with its nested lists as py_sublists, for everything
+                // py_vector can do.
+
+                list_t& elements() const { return tree_->nodes_[node_]; }
+
+                auto& operator[](std::size_t index) const { return elements()[index]; }
+
+                bool is_list(std::size_t index) const
+                {
+                    return std::holds_alternative<cpp_like_py::py_sublist>(elements()[index]);
+                }
+
+                // the list at 'index'.  std::bad_variant_access if it isn't one.
+
+                basic_list_ref sublist(std::size_t index) const
+                {
+                    return {tree_, std::get<cpp_like_py::py_sublist>(elements()[index]).node};
+                }
+
+                std::uint32_t node() const { return node_; }
+
+                void print_list(std::ostream& out, const cpp_like_py::format_options& options = {}) const
+                {
+                    auto& buffer = cpp_like_py::scratch_buffer();
+                    tree_->format_node(buffer, node_, options);
+                    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                }
+
+                [[nodiscard]] std::string to_string(const cpp_like_py::format_options& options = {}) const
+                {
+                    cpp_like_py::format_buffer buffer;
+                    tree_->format_node(buffer, node_, options);
+                    return buffer.release();
+                }
+
+                /* ====================  MUTATORS      ======================================= */
+
+                // nested lists only come from append_list.  A py_sublist made by hand could
+                // name any list in the tree, this one included.
+
+                template<typename T, bool C = Const, typename = std::enable_if_t<! C>>
+                basic_list_ref& append(T&& element)
+                {
+                    static_assert(! std::is_same_v<std::decay_t<T>, cpp_like_py::py_sublist>,
+                            "use append_list to add a nested list.");
+                    elements().append(std::forward<T>(element));
+                    return *this;
+                }
+
+                // a new, empty list on our end.
+
+                template<bool C = Const, typename = std::enable_if_t<! C>>
+                basic_list_ref append_list()
+                {
+                    const auto child = tree_->new_node();
+                    elements().append(cpp_like_py::py_sublist{child});
+                    return {tree_, child};
+                }
+
+                // a deep copy of 'source', which can be from any tree of the same type,
+                // this one included, on our end.
+
+                template<bool C = Const, typename = std::enable_if_t<! C>>
+                basic_list_ref append_list(basic_list_ref<true> source)
+                {
+                    const auto child = tree_->graft(*source.tree_, source.node_);
+                    elements().append(cpp_like_py::py_sublist{child});
+                    return {tree_, child};
+                }
+
+                // the lists among the erased elements, and everything in them, go back
+                // to the pool.
+
+                template<bool C = Const, typename = std::enable_if_t<! C>>
+                basic_list_ref& erase(std::size_t from, std::size_t to)
+                {
+                    std::vector<std::uint32_t> dropped;
+                    for (std::size_t i = from; i < to && i < size(); ++i)
+                    {
+                        if (const auto* sublist = std::get_if<cpp_like_py::py_sublist>(&std::as_const(elements())[i]))
+                        {
+                            dropped.push_back(sublist->node);
+                        }
+                    }
+                    elements().erase(from, to);
+                    tree_->release(std::move(dropped));
+                    return *this;
+                }
+
+                /* ====================  OPERATORS     ======================================= */
+
+                template<bool C>
+                bool operator==(const basic_list_ref<C>& rhs) const
+                {
+                    return nested_py_vector::equal(*tree_, node_, *rhs.tree_, rhs.node_);
+                }
+
+                template<bool C>
+                bool operator!=(const basic_list_ref<C>& rhs) const { return ! (*this == rhs); }
+
+            private:
+
+                template<bool> friend class basic_list_ref;
+                friend class nested_py_vector;
+
+                tree_t* tree_;
+                std::uint32_t node_;
+        };
+
+        using list_ref = basic_list_ref<false>;
+        using const_list_ref = basic_list_ref<true>;
+
+        /* ====================  LIFECYCLE     ======================================= */
+        nested_py_vector () : nodes_(1) { }                                 /* constructor */
+
+        // a deep copy of one list from any tree as a tree of its own.
+
+        explicit nested_py_vector (const_list_ref source) : nodes_(1)
+        {
+            copy_into(*source.tree_, source.node_, 0);
+        }
+
+        /* ====================  ACCESSORS     ======================================= */
+
+        list_ref root() { return {this, 0}; }
+        const_list_ref root() const { return {this, 0}; }
+
+        std::size_t size() const { return nodes_[0].size(); }
+        bool empty() const { return nodes_[0].size() == 0; }
+
+        // how many lists are in the tree, the top one included.
+
+        std::size_t list_count() const { return nodes_.size() - free_.size(); }
+
+        // how many T's there are, in nested lists as well unless 'recurse' is false.
+        // Lists on the free list are empty so each list's own count is just added up.
+
+        template<typename T>
+        std::size_t count_of(bool recurse = true) const
+        {
+            if (! recurse)
+            {
+                return nodes_[0].template count_of<T>();
+            }
+            std::size_t result{0};
+            for (const auto& node : nodes_)
+            {
+                result += node.template count_of<T>();
+            }
+            return result;
+        }
+
+        void print_list(std::ostream& out, const cpp_like_py::format_options& options = {}) const
+        {
+            root().print_list(out, options);
+        }
+
+        [[nodiscard]] std::string to_string(const cpp_like_py::format_options& options = {}) const
+        {
+            return root().to_string(options);
+        }
+
+        /* ====================  MUTATORS      ======================================= */
+
+        template<typename T>
+        nested_py_vector& append(T&& element)
+        {
+            static_assert(! std::is_same_v<std::decay_t<T>, cpp_like_py::py_sublist>,
+                    "use append_list to add a nested list.");
+            root().append(std::forward<T>(element));
+            return *this;
+        }
+
+        list_ref append_list() { return root().append_list(); }
+        list_ref append_list(const_list_ref source) { return root().append_list(source); }
+
+        // applies func to each element of type T in the order Python would print them,
+        // going into nested lists unless 'recurse' is false.
+
+        template<typename T, class F>
+        void visit_all(F&& func, bool recurse = true)
+        {
+            if (! recurse)
+            {
+                nodes_[0].template visit_all<T>(func);
+                return;
+            }
+
+            std::vector<std::pair<std::uint32_t, std::size_t>> pending{{0, 0}};
+            while (! pending.empty())
+            {
+                auto [node, index] = pending.back();
+                pending.pop_back();
+                for (; index < nodes_[node].size(); ++index)
+                {
+                    auto& elem = nodes_[node][index];
+                    if (const auto* sublist = std::get_if<cpp_like_py::py_sublist>(&elem))
+                    {
+                        pending.emplace_back(node, index + 1);
+                        pending.emplace_back(sublist->node, 0);
+                        break;
+                    }
+                    if (auto* value = std::get_if<T>(&elem))
+                    {
+                        func(*value);
+                    }
+                }
+            }
+        }
+
+        /* ====================  OPERATORS     ======================================= */
+
+        bool operator==(const nested_py_vector& rhs) const { return root() == rhs.root(); }
+        bool operator!=(const nested_py_vector& rhs) const { return ! (*this == rhs); }
+
+    private:
+
+        /* ====================  METHODS       ======================================= */
+
+        std::uint32_t new_node()
+        {
+            if (! free_.empty())
+            {
+                const auto node = free_.back();
+                free_.pop_back();
+                return node;
+            }
+            nodes_.emplace_back();
+            return static_cast<std::uint32_t>(nodes_.size() - 1);
+        }
+
+        // 'dropped' and every list under them go on the free list.
+
+        void release(std::vector<std::uint32_t> dropped)
+        {
+            while (! dropped.empty())
+            {
+                const auto node = dropped.back();
+                dropped.pop_back();
+                for (const auto& elem : nodes_[node])
+                {
+                    if (const auto* sublist = std::get_if<cpp_like_py::py_sublist>(&elem))
+                    {
+                        dropped.push_back(sublist->node);
+                    }
+                }
+                nodes_[node] = node_list{};
+                free_.push_back(node);
+            }
+        }
+
+        // a copy of list 'from_node' of 'from', and everything in it, as a new list in our
+        // pool.
+
+        std::uint32_t graft(const nested_py_vector& from, std::uint32_t from_node)
+        {
+            const auto top = new_node();
+            copy_into(from, from_node, top);
+            return top;
+        }
+
+        // 'from' can be us so nothing in it is held by reference across new_node().
+
+        void copy_into(const nested_py_vector& from, std::uint32_t from_node, std::uint32_t top)
+        {
+            std::vector<std::pair<std::uint32_t, std::uint32_t>> pending{{from_node, top}};
+            while (! pending.empty())
+            {
+                const auto [source, dest] = pending.back();
+                pending.pop_back();
+
+                const std::size_t count = from.nodes_[source].size();
+                nodes_[dest].reserve(count);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    if (const auto* sublist = std::get_if<cpp_like_py::py_sublist>(&from.nodes_[source][i]))
+                    {
+                        const auto child_source = sublist->node;
+                        const auto child = new_node();
+                        nodes_[dest].append(cpp_like_py::py_sublist{child});
+                        pending.emplace_back(child_source, child);
+                    }
+                    else
+                    {
+                        std::visit([this, dest](const auto& x) { nodes_[dest].append(x); }, from.nodes_[source][i]);
+                    }
+                }
+            }
+        }
+
+        static bool equal(const nested_py_vector& lhs, std::uint32_t lhs_node, const nested_py_vector& rhs, std::uint32_t rhs_node)
+        {
+            std::vector<std::pair<std::uint32_t, std::uint32_t>> pending{{lhs_node, rhs_node}};
+            while (! pending.empty())
+            {
+                const auto [a, b] = pending.back();
+                pending.pop_back();
+
+                const auto& left = lhs.nodes_[a];
+                const auto& right = rhs.nodes_[b];
+                if (left.size() != right.size())
+                {
+                    return false;
+                }
+                for (std::size_t i = 0; i < left.size(); ++i)
+                {
+                    const auto& x = left[i];
+                    const auto& y = right[i];
+                    if (x.index() != y.index())
+                    {
+                        return false;
+                    }
+                    if (const auto* sublist = std::get_if<cpp_like_py::py_sublist>(&x))
+                    {
+                        pending.emplace_back(sublist->node, std::get<cpp_like_py::py_sublist>(y).node);
+                    }
+                    else if (x != y)
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // [a, [b, c], d] then a newline, like print_list.
+
+        void format_node(cpp_like_py::format_buffer& buffer, std::uint32_t top, const cpp_like_py::format_options& options) const
+        {
+            auto format_item([&buffer, &options](const auto& e) { cpp_like_py::format_value(buffer, e, options); });
+
+            std::vector<std::pair<std::uint32_t, std::size_t>> pending{{top, 0}};
+            buffer.append('[');
+            while (! pending.empty())
+            {
+                auto [node, index] = pending.back();
+                pending.pop_back();
+
+                const auto& list = nodes_[node];
+                for (; index < list.size(); ++index)
+                {
+                    if (index != 0)
+                    {
+                        buffer.append(", ");
+                    }
+                    if (const auto* sublist = std::get_if<cpp_like_py::py_sublist>(&list[index]))
+                    {
+                        pending.emplace_back(node, index + 1);
+                        pending.emplace_back(sublist->node, 0);
+                        buffer.append('[');
+                        break;
+                    }
+                    std::visit(format_item, list[index]);
+                }
+                if (index == list.size())
+                {
+                    buffer.append(']');
+                }
+            }
+            buffer.append('\n');
+        }
+
+        /* ====================  DATA MEMBERS  ======================================= */
+
+        // nodes_[0] is the top list.
+
+        std::vector<node_list> nodes_;
+        std::vector<std::uint32_t> free_;
+
+}; /* ----------  end of template class nested_py_vector  ---------- */
+
+#endif   /* ----- #ifndef _NESTED_PY_VECTOR_INC_  ----- */
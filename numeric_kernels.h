@@ -0,0 +1,670 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  numeric_kernels.h
+ *
+ *    Description:  bulk numeric kernels (scale, add, clamp, sum, min, max) over
+ *                  contiguous arrays of arithmetic values.  Used by py_vector and
+ *                  partitioned_py_vector for their numeric operations.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 11:02:47 AM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  David P. Riedel (), driedel@cox.net
+ *   Organization:
+ *
+ * =====================================================================================
+ */
+
+
+#ifndef  _NUMERIC_KERNELS_INC_
+#define  _NUMERIC_KERNELS_INC_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <variant>
+
+#include <boost/mp11.hpp>
+
+// the instruction set is chosen at compile time.  The makefile passes -march=native
+// so we get the best the build machine has.  Define PY_VECTOR_NO_SIMD to force
+// the plain C++ versions.
+
+#if ! defined(PY_VECTOR_NO_SIMD) && defined(__AVX2__)
+    #define PY_VECTOR_SIMD_AVX2 1
+#elif ! defined(PY_VECTOR_NO_SIMD) && defined(__SSE2__)
+    #define PY_VECTOR_SIMD_SSE2 1
+#endif
+
+#if defined(PY_VECTOR_SIMD_AVX2) || defined(PY_VECTOR_SIMD_SSE2)
+    #include <immintrin.h>
+#endif
+
+namespace cpp_like_py
+{
+    // Python treats bool as a kind of int but a char is just a short string
+    // so we leave the character types out of our numeric operations.
+
+    template<typename T>
+    inline constexpr bool is_char_v = std::is_same_v<T, char> || std::is_same_v<T, signed char>
+        || std::is_same_v<T, unsigned char> || std::is_same_v<T, wchar_t>
+        || std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t>;
+
+    template<typename T>
+    inline constexpr bool is_py_numeric_v = std::is_arithmetic_v<T> && ! is_char_v<T>;
+
+    // Python has exactly 2 kinds of number we care about: int and float.
+    // Results which depend on what is actually in a list (like sum()) come back as one of these.
+
+    using py_number = std::variant<std::int64_t, double>;
+
+    namespace kernels
+    {
+        // integers are summed in 64 bits, floating point in (at least) double just like Python.
+
+        template<typename T>
+        using sum_t = std::conditional_t<std::is_floating_point_v<T>,
+                std::conditional_t<std::is_same_v<T, long double>, long double, double>,
+                std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>>;
+
+#if defined(PY_VECTOR_SIMD_AVX2)
+        inline constexpr const char* simd_name = "avx2";
+#elif defined(PY_VECTOR_SIMD_SSE2)
+        inline constexpr const char* simd_name = "sse2";
+#else
+        inline constexpr const char* simd_name = "scalar";
+#endif
+
+        template<typename T>
+        inline constexpr bool is_int32_v = std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) == 4;
+
+        // horizontal reductions of a vector register.  Only needed by the SIMD paths.
+
+#if defined(PY_VECTOR_SIMD_AVX2)
+        inline double hsum(__m256d v)
+        {
+            alignas(32) double lanes[4];
+            _mm256_store_pd(lanes, v);
+            return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        }
+#endif
+
+        template<typename T>
+        void scale(T* data, std::size_t count, T factor)
+        {
+            std::size_t i{0};
+#if defined(PY_VECTOR_SIMD_AVX2)
+            if constexpr(std::is_same_v<T, float>)
+            {
+                const __m256 f = _mm256_set1_ps(factor);
+                for (; i + 8 <= count; i += 8)
+                {
+                    _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), f));
+                }
+            }
+            else if constexpr(std::is_same_v<T, double>)
+            {
+                const __m256d f = _mm256_set1_pd(factor);
+                for (; i + 4 <= count; i += 4)
+                {
+                    _mm256_storeu_pd(data + i, _mm256_mul_pd(_mm256_loadu_pd(data + i), f));
+                }
+            }
+            else if constexpr(is_int32_v<T>)
+            {
+                const __m256i f = _mm256_set1_epi32(factor);
+                for (; i + 8 <= count; i += 8)
+                {
+                    auto* p = reinterpret_cast<__m256i*>(data + i);
+                    _mm256_storeu_si256(p, _mm256_mullo_epi32(_mm256_loadu_si256(p), f));
+                }
+            }
+#elif defined(PY_VECTOR_SIMD_SSE2)
+            if constexpr(std::is_same_v<T, float>)
+            {
+                const __m128 f = _mm_set1_ps(factor);
+                for (; i + 4 <= count; i += 4)
+                {
+                    _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), f));
+                }
+            }
+            else if constexpr(std::is_same_v<T, double>)
+            {
+                const __m128d f = _mm_set1_pd(factor);
+                for (; i + 2 <= count; i += 2)
+                {
+                    _mm_storeu_pd(data + i, _mm_mul_pd(_mm_loadu_pd(data + i), f));
+                }
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                data[i] *= factor;
+            }
+        }
+
+        template<typename T>
+        void add(T* data, std::size_t count, T value)
+        {
+            std::size_t i{0};
+#if defined(PY_VECTOR_SIMD_AVX2)
+            if constexpr(std::is_same_v<T, float>)
+            {
+                const __m256 v = _mm256_set1_ps(value);
+                for (; i + 8 <= count; i += 8)
+                {
+                    _mm256_storeu_ps(data + i, _mm256_add_ps(_mm256_loadu_ps(data + i), v));
+                }
+            }
+            else if constexpr(std::is_same_v<T, double>)
+            {
+                const __m256d v = _mm256_set1_pd(value);
+                for (; i + 4 <= count; i += 4)
+                {
+                    _mm256_storeu_pd(data + i, _mm256_add_pd(_mm256_loadu_pd(data + i), v));
+                }
+            }
+            else if constexpr(is_int32_v<T>)
+            {
+                const __m256i v = _mm256_set1_epi32(value);
+                for (; i + 8 <= count; i += 8)
+                {
+                    auto* p = reinterpret_cast<__m256i*>(data + i);
+                    _mm256_storeu_si256(p, _mm256_add_epi32(_mm256_loadu_si256(p), v));
+                }
+            }
+#elif defined(PY_VECTOR_SIMD_SSE2)
+            if constexpr(std::is_same_v<T, float>)
+            {
+                const __m128 v = _mm_set1_ps(value);
+                for (; i + 4 <= count; i += 4)
+                {
+                    _mm_storeu_ps(data + i, _mm_add_ps(_mm_loadu_ps(data + i), v));
+                }
+            }
+            else if constexpr(std::is_same_v<T, double>)
+            {
+                const __m128d v = _mm_set1_pd(value);
+                for (; i + 2 <= count; i += 2)
+                {
+                    _mm_storeu_pd(data + i, _mm_add_pd(_mm_loadu_pd(data + i), v));
+                }
+            }
+            else if constexpr(is_int32_v<T>)
+            {
+                const __m128i v = _mm_set1_epi32(value);
+                for (; i + 4 <= count; i += 4)
+                {
+                    auto* p = reinterpret_cast<__m128i*>(data + i);
+                    _mm_storeu_si128(p, _mm_add_epi32(_mm_loadu_si128(p), v));
+                }
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                data[i] += value;
+            }
+        }
+
+        // a NaN stays a NaN, as it does in the plain loop.  The SIMD min and max give back
+        // their second operand when either one is NaN so the value goes second.
+
+        template<typename T>
+        void clamp(T* data, std::size_t count, T low, T high)
+        {
+            std::size_t i{0};
+#if defined(PY_VECTOR_SIMD_AVX2)
+            if constexpr(std::is_same_v<T, float>)
+            {
+                const __m256 lo = _mm256_set1_ps(low);
+                const __m256 hi = _mm256_set1_ps(high);
+                for (; i + 8 <= count; i += 8)
+                {
+                    _mm256_storeu_ps(data + i, _mm256_min_ps(hi, _mm256_max_ps(lo, _mm256_loadu_ps(data + i))));
+                }
+            }
+            else if constexpr(std::is_same_v<T, double>)
+            {
+                const __m256d lo = _mm256_set1_pd(low);
+                const __m256d hi = _mm256_set1_pd(high);
+                for (; i + 4 <= count; i += 4)
+                {
+                    _mm256_storeu_pd(data + i, _mm256_min_pd(hi, _mm256_max_pd(lo, _mm256_loadu_pd(data + i))));
+                }
+            }
+            else if constexpr(is_int32_v<T>)
+            {
+                const __m256i lo = _mm256_set1_epi32(low);
+                const __m256i hi = _mm256_set1_epi32(high);
+                for (; i + 8 <= count; i += 8)
+                {
+                    auto* p = reinterpret_cast<__m256i*>(data + i);
+                    _mm256_storeu_si256(p, _mm256_min_epi32(_mm256_max_epi32(_mm256_loadu_si256(p), lo), hi));
+                }
+            }
+#elif defined(PY_VECTOR_SIMD_SSE2)
+            if constexpr(std::is_same_v<T, float>)
+            {
+                const __m128 lo = _mm_set1_ps(low);
+                const __m128 hi = _mm_set1_ps(high);
+                for (; i + 4 <= count; i += 4)
+                {
+                    _mm_storeu_ps(data + i, _mm_min_ps(hi, _mm_max_ps(lo, _mm_loadu_ps(data + i))));
+                }
+            }
+            else if constexpr(std::is_same_v<T, double>)
+            {
+                const __m128d lo = _mm_set1_pd(low);
+                const __m128d hi = _mm_set1_pd(high);
+                for (; i + 2 <= count; i += 2)
+                {
+                    _mm_storeu_pd(data + i, _mm_min_pd(hi, _mm_max_pd(lo, _mm_loadu_pd(data + i))));
+                }
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                data[i] = std::min(std::max(data[i], low), high);
+            }
+        }
+
+        // NOTE: the SIMD versions add in a different order than the plain loop so
+        // floating point results can differ from it in the last few bits.
+
+        template<typename T>
+        sum_t<T> sum(const T* data, std::size_t count)
+        {
+            std::size_t i{0};
+            sum_t<T> result{0};
+#if defined(PY_VECTOR_SIMD_AVX2)
+            if constexpr(std::is_same_v<T, float>)
+            {
+                __m256d acc_lo = _mm256_setzero_pd();
+                __m256d acc_hi = _mm256_setzero_pd();
+                for (; i + 8 <= count; i += 8)
+                {
+                    const __m256 v = _mm256_loadu_ps(data + i);
+                    acc_lo = _mm256_add_pd(acc_lo, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+                    acc_hi = _mm256_add_pd(acc_hi, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+                }
+                result = hsum(_mm256_add_pd(acc_lo, acc_hi));
+            }
+            else if constexpr(std::is_same_v<T, double>)
+            {
+                __m256d acc = _mm256_setzero_pd();
+                for (; i + 4 <= count; i += 4)
+                {
+                    acc = _mm256_add_pd(acc, _mm256_loadu_pd(data + i));
+                }
+                result = hsum(acc);
+            }
+            else if constexpr(is_int32_v<T>)
+            {
+                __m256i acc = _mm256_setzero_si256();
+                for (; i + 8 <= count; i += 8)
+                {
+                    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                    acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+                    acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+                }
+                alignas(32) std::int64_t lanes[4];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+                result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+            }
+#elif defined(PY_VECTOR_SIMD_SSE2)
+            if constexpr(std::is_same_v<T, float>)
+            {
+                __m128d acc_lo = _mm_setzero_pd();
+                __m128d acc_hi = _mm_setzero_pd();
+                for (; i + 4 <= count; i += 4)
+                {
+                    const __m128 v = _mm_loadu_ps(data + i);
+                    acc_lo = _mm_add_pd(acc_lo, _mm_cvtps_pd(v));
+                    acc_hi = _mm_add_pd(acc_hi, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+                }
+                alignas(16) double lanes[2];
+                _mm_store_pd(lanes, _mm_add_pd(acc_lo, acc_hi));
+                result = lanes[0] + lanes[1];
+            }
+            else if constexpr(std::is_same_v<T, double>)
+            {
+                __m128d acc = _mm_setzero_pd();
+                for (; i + 2 <= count; i += 2)
+                {
+                    acc = _mm_add_pd(acc, _mm_loadu_pd(data + i));
+                }
+                alignas(16) double lanes[2];
+                _mm_store_pd(lanes, acc);
+                result = lanes[0] + lanes[1];
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                result += data[i];
+            }
+            return result;
+        }
+
+        // min and max expect at least 1 element.
+        //
+        // NaN works as it does in Python and the plain loops: every comparison with it is
+        // false so it is the answer if it comes first and is skipped anywhere else.  The
+        // SIMD min and max give back their second operand when either one is NaN so the
+        // running result goes second and starts out as the first element.
+
+        template<typename T>
+        T min(const T* data, std::size_t count)
+        {
+            std::size_t i{0};
+            T result = data[0];
+            if constexpr(std::is_floating_point_v<T>)
+            {
+                if (result != result)
+                {
+                    return result;
+                }
+            }
+#if defined(PY_VECTOR_SIMD_AVX2)
+            if constexpr(std::is_same_v<T, float>)
+            {
+                if (count >= 8)
+                {
+                    __m256 acc = _mm256_set1_ps(result);
+                    for (; i + 8 <= count; i += 8)
+                    {
+                        acc = _mm256_min_ps(_mm256_loadu_ps(data + i), acc);
+                    }
+                    alignas(32) float lanes[8];
+                    _mm256_store_ps(lanes, acc);
+                    result = *std::min_element(lanes, lanes + 8);
+                }
+            }
+            else if constexpr(std::is_same_v<T, double>)
+            {
+                if (count >= 4)
+                {
+                    __m256d acc = _mm256_set1_pd(result);
+                    for (; i + 4 <= count; i += 4)
+                    {
+                        acc = _mm256_min_pd(_mm256_loadu_pd(data + i), acc);
+                    }
+                    alignas(32) double lanes[4];
+                    _mm256_store_pd(lanes, acc);
+                    result = *std::min_element(lanes, lanes + 4);
+                }
+            }
+            else if constexpr(is_int32_v<T>)
+            {
+                if (count >= 8)
+                {
+                    __m256i acc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+                    for (i = 8; i + 8 <= count; i += 8)
+                    {
+                        acc = _mm256_min_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+                    }
+                    alignas(32) T lanes[8];
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+                    result = *std::min_element(lanes, lanes + 8);
+                }
+            }
+#elif defined(PY_VECTOR_SIMD_SSE2)
+            if constexpr(std::is_same_v<T, float>)
+            {
+                if (count >= 4)
+                {
+                    __m128 acc = _mm_set1_ps(result);
+                    for (; i + 4 <= count; i += 4)
+                    {
+                        acc = _mm_min_ps(_mm_loadu_ps(data + i), acc);
+                    }
+                    alignas(16) float lanes[4];
+                    _mm_store_ps(lanes, acc);
+                    result = *std::min_element(lanes, lanes + 4);
+                }
+            }
+            else if constexpr(std::is_same_v<T, double>)
+            {
+                if (count >= 2)
+                {
+                    __m128d acc = _mm_set1_pd(result);
+                    for (; i + 2 <= count; i += 2)
+                    {
+                        acc = _mm_min_pd(_mm_loadu_pd(data + i), acc);
+                    }
+                    alignas(16) double lanes[2];
+                    _mm_store_pd(lanes, acc);
+                    result = std::min(lanes[0], lanes[1]);
+                }
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                if (data[i] < result)
+                {
+                    result = data[i];
+                }
+            }
+            return result;
+        }
+
+        template<typename T>
+        T max(const T* data, std::size_t count)
+        {
+            std::size_t i{0};
+            T result = data[0];
+            if constexpr(std::is_floating_point_v<T>)
+            {
+                if (result != result)
+                {
+                    return result;
+                }
+            }
+#if defined(PY_VECTOR_SIMD_AVX2)
+            if constexpr(std::is_same_v<T, float>)
+            {
+                if (count >= 8)
+                {
+                    __m256 acc = _mm256_set1_ps(result);
+                    for (; i + 8 <= count; i += 8)
+                    {
+                        acc = _mm256_max_ps(_mm256_loadu_ps(data + i), acc);
+                    }
+                    alignas(32) float lanes[8];
+                    _mm256_store_ps(lanes, acc);
+                    result = *std::max_element(lanes, lanes + 8);
+                }
+            }
+            else if constexpr(std::is_same_v<T, double>)
+            {
+                if (count >= 4)
+                {
+                    __m256d acc = _mm256_set1_pd(result);
+                    for (; i + 4 <= count; i += 4)
+                    {
+                        acc = _mm256_max_pd(_mm256_loadu_pd(data + i), acc);
+                    }
+                    alignas(32) double lanes[4];
+                    _mm256_store_pd(lanes, acc);
+                    result = *std::max_element(lanes, lanes + 4);
+                }
+            }
+            else if constexpr(is_int32_v<T>)
+            {
+                if (count >= 8)
+                {
+                    __m256i acc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+                    for (i = 8; i + 8 <= count; i += 8)
+                    {
+                        acc = _mm256_max_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+                    }
+                    alignas(32) T lanes[8];
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+                    result = *std::max_element(lanes, lanes + 8);
+                }
+            }
+#elif defined(PY_VECTOR_SIMD_SSE2)
+            if constexpr(std::is_same_v<T, float>)
+            {
+                if (count >= 4)
+                {
+                    __m128 acc = _mm_set1_ps(result);
+                    for (; i + 4 <= count; i += 4)
+                    {
+                        acc = _mm_max_ps(_mm_loadu_ps(data + i), acc);
+                    }
+                    alignas(16) float lanes[4];
+                    _mm_store_ps(lanes, acc);
+                    result = *std::max_element(lanes, lanes + 4);
+                }
+            }
+            else if constexpr(std::is_same_v<T, double>)
+            {
+                if (count >= 2)
+                {
+                    __m128d acc = _mm_set1_pd(result);
+                    for (; i + 2 <= count; i += 2)
+                    {
+                        acc = _mm_max_pd(_mm_loadu_pd(data + i), acc);
+                    }
+                    alignas(16) double lanes[2];
+                    _mm_store_pd(lanes, acc);
+                    result = std::max(lanes[0], lanes[1]);
+                }
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                if (result < data[i])
+                {
+                    result = data[i];
+                }
+            }
+            return result;
+        }
+    }		/* -----  end of namespace kernels  ----- */
+
+    // compare 2 numbers of possibly different arithmetic types by value.
+    // long double can hold any 64 bit integer exactly on the machines we build for.
+
+    template<typename X, typename Y>
+    bool numeric_less(const X& x, const Y& y)
+    {
+        if constexpr(std::is_integral_v<X> && std::is_integral_v<Y>)
+        {
+            if constexpr(std::is_signed_v<X> == std::is_signed_v<Y>)
+            {
+                return x < y;
+            }
+            else
+            {
+                return static_cast<long double>(x) < static_cast<long double>(y);
+            }
+        }
+        else
+        {
+            return static_cast<long double>(x) < static_cast<long double>(y);
+        }
+    }
+
+    // the reductions work the same for every container in this project.  Each container
+    // supplies 'visit_blocks' which calls func(I, data, count) for contiguous blocks of
+    // the numeric alternative I of its type signature.  How it comes up with those blocks
+    // depends on how it stores its elements.
+
+    template<typename VisitBlocks>
+    py_number sum_of_blocks(VisitBlocks&& visit_blocks)
+    {
+        std::int64_t int_total{0};
+        double float_total{0.0};
+        bool saw_float{false};
+
+        visit_blocks([&](auto, const auto* data, std::size_t count)
+        {
+            using X = std::remove_cv_t<std::remove_pointer_t<decltype(data)>>;
+            if constexpr(std::is_floating_point_v<X>)
+            {
+                float_total += static_cast<double>(kernels::sum(data, count));
+                saw_float = true;
+            }
+            else
+            {
+                int_total += static_cast<std::int64_t>(kernels::sum(data, count));
+            }
+        });
+
+        // just like Python, one float anywhere in the list makes the result a float.
+
+        if (saw_float)
+        {
+            return py_number{std::in_place_type<double>, float_total + static_cast<double>(int_total)};
+        }
+        return py_number{std::in_place_type<std::int64_t>, int_total};
+    }
+
+    template<typename VisitBlocks>
+    double mean_of_blocks(VisitBlocks&& visit_blocks)
+    {
+        double total{0.0};
+        std::size_t how_many{0};
+
+        visit_blocks([&](auto, const auto* data, std::size_t count)
+        {
+            total += static_cast<double>(kernels::sum(data, count));
+            how_many += count;
+        });
+
+        if (how_many == 0)
+        {
+            throw std::invalid_argument{"mean requires at least one data point"};
+        }
+        return total / static_cast<double>(how_many);
+    }
+
+    // min and max give back the element itself, keeping its type, like Python does.
+
+    template<typename Variant, bool Max, typename VisitBlocks>
+    Variant extreme_of_blocks(VisitBlocks&& visit_blocks)
+    {
+        std::optional<Variant> best;
+
+        visit_blocks([&](auto I, const auto* data, std::size_t count)
+        {
+            using X = std::remove_cv_t<std::remove_pointer_t<decltype(data)>>;
+            const X candidate = Max ? kernels::max(data, count) : kernels::min(data, count);
+
+            if (! best)
+            {
+                best.emplace(std::in_place_index<I>, candidate);
+                return;
+            }
+            bool replace{false};
+            boost::mp11::mp_with_index<std::variant_size_v<Variant>>(best->index(), [&](auto J)
+            {
+                using Y = std::variant_alternative_t<J, Variant>;
+                if constexpr(is_py_numeric_v<Y>)
+                {
+                    const Y& current = std::get<J>(*best);
+                    replace = Max ? numeric_less(current, candidate) : numeric_less(candidate, current);
+                }
+            });
+            if (replace)
+            {
+                best.emplace(std::in_place_index<I>, candidate);
+            }
+        });
+
+        if (! best)
+        {
+            throw std::invalid_argument{Max ? "max() arg is an empty sequence" : "min() arg is an empty sequence"};
+        }
+        return *best;
+    }
+}		/* -----  end of namespace cpp_like_py  ----- */
+
+#endif   /* ----- #ifndef _NUMERIC_KERNELS_INC_  ----- */
@@ -0,0 +1,137 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  parallel_chunks.h
+ *
+ *    Description:  execution policies for the py_vector bulk operations and the
+ *                  little thread pool which runs them.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 05:12:18 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  David P. Riedel (), driedel@cox.net
+ *   Organization:
+ *
+ * =====================================================================================
+ */
+
+
+#ifndef  _PARALLEL_CHUNKS_INC_
+#define  _PARALLEL_CHUNKS_INC_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cpp_like_py
+{
+    // we don't use the std::execution policies because, with gcc, including <execution>
+    // at all means linking against TBB.  These are spelled the same way so code reads the same.
+
+    namespace execution
+    {
+        struct sequenced_policy { };
+
+        // 'threads' == 0 means use every core.  Elements are handed out 'chunk_size' at a time.
+        // The chunks don't depend on the number of threads so reductions come out the
+        // same no matter how many cores we run on.
+
+        struct parallel_policy
+        {
+            std::size_t threads = 0;
+            std::size_t chunk_size = 16 * 1024;
+        };
+
+        inline constexpr sequenced_policy seq{};
+        inline constexpr parallel_policy par{};
+
+        template<typename P>
+        inline constexpr bool is_execution_policy_v = std::is_same_v<std::decay_t<P>, sequenced_policy>
+            || std::is_same_v<std::decay_t<P>, parallel_policy>;
+    }		/* -----  end of namespace execution  ----- */
+
+    // calls func(chunk, first, last) for each chunk of [0, count).  Worker threads take
+    // the next unclaimed chunk until there are none left so a slow chunk doesn't hold up
+    // the others.  The calling thread works too.  If func throws, no new chunks are
+    // started and the first exception is rethrown here once everyone has stopped.
+
+    template<typename F>
+    void for_each_chunk(const execution::parallel_policy& policy, std::size_t count, F&& func)
+    {
+        const std::size_t chunk_size = std::max<std::size_t>(policy.chunk_size, 1);
+        const std::size_t chunks = (count + chunk_size - 1) / chunk_size;
+        if (chunks == 0)
+        {
+            return;
+        }
+
+        std::size_t threads = policy.threads != 0 ? policy.threads : std::thread::hardware_concurrency();
+        threads = std::clamp<std::size_t>(threads, 1, chunks);
+
+        std::atomic<std::size_t> next_chunk{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr first_error;
+        std::mutex error_mutex;
+
+        auto work([&]
+        {
+            for (std::size_t chunk = next_chunk++; chunk < chunks && ! failed; chunk = next_chunk++)
+            {
+                try
+                {
+                    const std::size_t first = chunk * chunk_size;
+                    func(chunk, first, std::min(first + chunk_size, count));
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock{error_mutex};
+                    if (! failed.exchange(true))
+                    {
+                        first_error = std::current_exception();
+                    }
+                }
+            }
+        });
+
+        std::vector<std::thread> helpers;
+        helpers.reserve(threads - 1);
+        for (std::size_t i = 1; i < threads; ++i)
+        {
+            try
+            {
+                helpers.emplace_back(work);
+            }
+            catch (const std::system_error&)
+            {
+                // make do with the threads we have.
+                break;
+            }
+        }
+        work();
+        for (auto& helper : helpers)
+        {
+            helper.join();
+        }
+
+        if (first_error)
+        {
+            std::rethrow_exception(first_error);
+        }
+    }
+
+    inline std::size_t chunk_count(const execution::parallel_policy& policy, std::size_t count)
+    {
+        const std::size_t chunk_size = std::max<std::size_t>(policy.chunk_size, 1);
+        return (count + chunk_size - 1) / chunk_size;
+    }
+}		/* -----  end of namespace cpp_like_py  ----- */
+
+#endif   /* ----- #ifndef _PARALLEL_CHUNKS_INC_  ----- */
@@ -0,0 +1,746 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  partitioned_py_vector.h
+ *
+ *    Description:  python-like list for C++17 which keeps its elements partitioned
+ *                  by type (struct-of-arrays) instead of in a vector of variants.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 09:12:31 AM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  David P. Riedel (), driedel@cox.net
+ *   Organization:
+ *
+ * =====================================================================================
+ */
+
+
+#ifndef  _PARTITIONED_PY_VECTOR_INC_
+#define  _PARTITIONED_PY_VECTOR_INC_
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+
+#include "py_vector.h"
+
+/*
+ * =====================================================================================
+ *        Class:  partitioned_py_vector
+ *  Description:  provides a Python-like list class for C++ which stores its elements
+ *                in one contiguous std::vector per alternative in its type signature
+ *                plus a compact tag/slot array which records Python order.
+ * =====================================================================================
+ */
+
+// py_vector keeps a std::vector<std::variant<Ts...>> so every element costs the size of
+// the largest alternative plus the variant's index.  Here, a float costs a float plus
+// a 1 byte tag and a 4 byte slot number.  Also, visit_all<T> only needs to sweep
+// the vector(s) holding T instead of checking every element in the list.
+//
+// The invariant which makes this work: the elements of alternative I appear in partition I
+// in the same order they appear in the list.  So, the slot of an element is the number
+// of elements of the same alternative ahead of it in the list.
+
+template<typename ...Ts>
+class partitioned_py_vector
+{
+    static_assert(! mp11::mp_contains<mp11::mp_list<Ts...>, bool>::value,
+            "partitioned_py_vector can not hold bool since std::vector<bool> does not store actual bools.");
+
+    public:
+
+        using value_type = std::variant<Ts...>;
+        using tag_type = type_tag_t<sizeof...(Ts)>;
+        using slot_type = std::uint32_t;
+        using partitions_t = std::tuple<std::vector<Ts>...>;
+
+        // since we don't store variants, we can't hand out references to them.
+        // The non-const index operator returns this proxy instead.  It can be read as a
+        // variant or assigned to with anything our variant can be constructed from.
+
+        class reference
+        {
+            public:
+
+                reference(partitioned_py_vector* owner, std::size_t pos) : owner_{owner}, pos_{pos} { }
+
+                template<typename T>
+                reference& operator=(T&& value)
+                {
+                    owner_->assign_value(pos_, value_type(std::forward<T>(value)));
+                    return *this;
+                }
+
+                reference& operator=(const reference& rhs)
+                {
+                    owner_->assign_value(pos_, static_cast<value_type>(rhs));
+                    return *this;
+                }
+
+                operator value_type() const { return owner_->get_value(pos_); }
+
+                std::size_t index() const { return owner_->tags_[pos_]; }
+
+                bool operator==(const value_type& rhs) const { return owner_->get_value(pos_) == rhs; }
+                bool operator!=(const value_type& rhs) const { return ! (*this == rhs); }
+
+            private:
+
+                partitioned_py_vector* owner_;
+                std::size_t pos_;
+        };
+
+        // iterates in Python order.  Elements are materialized as variants as we go.
+
+        class const_iterator
+        {
+            public:
+
+                using iterator_category = std::input_iterator_tag;
+                using value_type = partitioned_py_vector::value_type;
+                using difference_type = std::ptrdiff_t;
+                using pointer = void;
+                using reference = value_type;
+
+                const_iterator(const partitioned_py_vector* owner, std::size_t pos) : owner_{owner}, pos_{pos} { }
+
+                value_type operator*() const { return owner_->get_value(pos_); }
+
+                const_iterator& operator++() { ++pos_; return *this; }
+                const_iterator operator++(int) { auto result{*this}; ++pos_; return result; }
+
+                bool operator==(const const_iterator& rhs) const { return pos_ == rhs.pos_; }
+                bool operator!=(const const_iterator& rhs) const { return pos_ != rhs.pos_; }
+
+            private:
+
+                const partitioned_py_vector* owner_;
+                std::size_t pos_;
+        };
+
+        /* ====================  LIFECYCLE     ======================================= */
+        partitioned_py_vector () = default;                                  /* constructor */
+        ~partitioned_py_vector () = default;
+
+        partitioned_py_vector (std::initializer_list<value_type> values)
+        {
+            reserve_order(values.size());
+            for (const auto& value : values)
+            {
+                push_value(value);
+            }
+        }
+
+        partitioned_py_vector(const partitioned_py_vector& rhs) = default;
+        partitioned_py_vector(partitioned_py_vector&& rhs) noexcept = default;
+
+        template<typename S, typename ... Us>
+        explicit partitioned_py_vector(const basic_py_vector<S, Us...>& rhs)
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>,
+                    "rhs py_vector type signature must be proper subset to copy construct.");
+
+            reserve_order(rhs.size());
+            for (const auto& r_element : rhs)
+            {
+                push_foreign_value(r_element);
+            }
+        }
+
+        template<typename ... Us>
+        explicit partitioned_py_vector(const partitioned_py_vector<Us...>& rhs)
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>,
+                    "rhs py_vector type signature must be proper subset to copy construct.");
+
+            reserve_order(rhs.size());
+            for (std::size_t i = 0; i < rhs.size(); ++i)
+            {
+                push_foreign_value(rhs.get_value(i));
+            }
+        }
+
+        template<typename ...Us> friend class partitioned_py_vector;
+
+        /* ====================  ACCESSORS     ======================================= */
+
+        auto size() const { return tags_.size(); }
+        auto empty() const { return tags_.empty(); }
+        auto begin() const { return const_iterator{this, 0}; }
+        auto cbegin() const { return const_iterator{this, 0}; }
+        auto end() const { return const_iterator{this, tags_.size()}; }
+        auto cend() const { return const_iterator{this, tags_.size()}; }
+
+        // same elements, same order, but stored as a regular py_vector.
+
+        [[nodiscard]] py_vector<Ts...> to_py_vector() const
+        {
+            py_vector<Ts...> result;
+            result.reserve(tags_.size());
+            for (std::size_t i = 0; i < tags_.size(); ++i)
+            {
+                mp11::mp_with_index<sizeof...(Ts)>(tags_[i], [&](auto I)
+                {
+                    using X = std::variant_alternative_t<I, value_type>;
+                    result.template emplace<X>(std::get<I>(partitions_)[slots_[i]]);
+                });
+            }
+            return result;
+        }
+
+        void print_list(std::ostream& out, const cpp_like_py::format_options& options = {}) const
+        {
+            auto& buffer = cpp_like_py::scratch_buffer();
+            format_to(buffer, options);
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        }
+
+        [[nodiscard]] std::string to_string(const cpp_like_py::format_options& options = {}) const
+        {
+            cpp_like_py::format_buffer buffer;
+            format_to(buffer, options);
+            return buffer.release();
+        }
+
+        // formats straight from the partitions, no variants built along the way.
+
+        void format_to(cpp_like_py::format_buffer& buffer, const cpp_like_py::format_options& options = {}) const
+        {
+            buffer.append('[');
+
+            for (std::size_t i = 0; i < tags_.size(); ++i)
+            {
+                if (i != 0)
+                {
+                    buffer.append(", ");
+                }
+                mp11::mp_with_index<sizeof...(Ts)>(tags_[i], [&](auto I)
+                {
+                    cpp_like_py::format_value(buffer, std::get<I>(partitions_)[slots_[i]], options);
+                });
+            }
+            buffer.append("]\n");
+        }
+
+        // half open range, like Python's x[lower:upper].  Negative bounds count back
+        // from the end and bounds past either end are pulled back in.
+
+        partitioned_py_vector slice(int lower_bound, int upper_bound) const
+        {
+            const auto where = py_slice{lower_bound, upper_bound}.resolve(tags_.size());
+            const auto start = static_cast<std::size_t>(where.start);
+
+            partitioned_py_vector result;
+            result.reserve_order(where.count);
+            for (std::size_t i = start; i < start + where.count; ++i)
+            {
+                mp11::mp_with_index<sizeof...(Ts)>(tags_[i], [&](auto I)
+                {
+                    result.template push_alternative<I>(std::get<I>(partitions_)[slots_[i]]);
+                });
+            }
+            return result;
+        }
+
+        // we only need to look at the partition(s) which can hold a Y.
+
+        template<typename Y>
+        bool contains(const Y& item) const
+        {
+            bool result{false};
+            mp11::mp_for_each<mp11::mp_iota_c<sizeof...(Ts)>>([&](auto I)
+            {
+                using X = std::variant_alternative_t<I, value_type>;
+                if constexpr(std::is_same_v<X, Y>)
+                {
+                    if (! result)
+                    {
+                        const auto& partition = std::get<I>(partitions_);
+                        result = std::find(partition.cbegin(), partition.cend(), item) != partition.cend();
+                    }
+                }
+            });
+            return result;
+        }
+
+        // this method will apply the supplied function to all list elements
+        // of the specified type.  Since all the elements of a given alternative are
+        // contiguous, this is a straight sweep through that partition.
+        // NOTE: if T appears more than once in our type signature, each partition
+        // holding T is swept in turn so elements are visited partition by partition.
+
+        template<typename T, class F>
+        void visit_all(F& func)
+        {
+            using good_type = mp11::mp_contains<new_types_set_<Ts...>, T>;
+            static_assert(std::is_same_v<good_type, mp11::mp_true>, "Type T must be in type signature of py_vector.");
+
+            mp11::mp_for_each<mp11::mp_iota_c<sizeof...(Ts)>>([&](auto I)
+            {
+                using X = std::variant_alternative_t<I, value_type>;
+                if constexpr (std::is_same_v<T, X>)
+                {
+                    for (X& x : std::get<I>(partitions_))
+                    {
+                        func(x);
+                    }
+                }
+            });
+        }
+
+        // bulk numeric operations.  Our partitions are contiguous so they go straight
+        // to the SIMD kernels from numeric_kernels.h.
+
+        template<typename T>
+        void scale_all(T factor)
+        {
+            static_assert(cpp_like_py::is_py_numeric_v<T>, "Type T must be a numeric type.");
+            for_each_partition_of_type<T>([factor](T* data, std::size_t count)
+            {
+                cpp_like_py::kernels::scale(data, count, factor);
+            });
+        }
+
+        template<typename T>
+        void add_all(T value)
+        {
+            static_assert(cpp_like_py::is_py_numeric_v<T>, "Type T must be a numeric type.");
+            for_each_partition_of_type<T>([value](T* data, std::size_t count)
+            {
+                cpp_like_py::kernels::add(data, count, value);
+            });
+        }
+
+        template<typename T>
+        void clamp_all(T low, T high)
+        {
+            static_assert(cpp_like_py::is_py_numeric_v<T>, "Type T must be a numeric type.");
+            for_each_partition_of_type<T>([low, high](T* data, std::size_t count)
+            {
+                cpp_like_py::kernels::clamp(data, count, low, high);
+            });
+        }
+
+        [[nodiscard]] cpp_like_py::py_number sum() const
+        {
+            return cpp_like_py::sum_of_blocks([this](auto&& func) { this->for_each_numeric_partition(func); });
+        }
+
+        [[nodiscard]] double mean() const
+        {
+            return cpp_like_py::mean_of_blocks([this](auto&& func) { this->for_each_numeric_partition(func); });
+        }
+
+        [[nodiscard]] value_type min() const
+        {
+            return cpp_like_py::extreme_of_blocks<value_type, false>([this](auto&& func) { this->for_each_numeric_partition(func); });
+        }
+
+        [[nodiscard]] value_type max() const
+        {
+            return cpp_like_py::extreme_of_blocks<value_type, true>([this](auto&& func) { this->for_each_numeric_partition(func); });
+        }
+
+        // direct access to the element at 'index' when the caller knows its type.
+
+        template<typename T>
+        T& get(std::size_t index)
+        {
+            return std::get<mp11::mp_find<mp11::mp_list<Ts...>, T>::value>(partitions_).at(checked_slot<T>(index));
+        }
+
+        template<typename T>
+        const T& get(std::size_t index) const
+        {
+            return std::get<mp11::mp_find<mp11::mp_list<Ts...>, T>::value>(partitions_).at(checked_slot<T>(index));
+        }
+
+        /* ====================  MUTATORS      ======================================= */
+
+        void reserve_order(std::size_t new_capacity)
+        {
+            tags_.reserve(new_capacity);
+            slots_.reserve(new_capacity);
+        }
+
+        partitioned_py_vector& append(const partitioned_py_vector& rhs)
+        {
+            if (this != &rhs)
+            {
+                reserve_order(tags_.size() + rhs.tags_.size());
+                for (std::size_t i = 0; i < rhs.tags_.size(); ++i)
+                {
+                    mp11::mp_with_index<sizeof...(Ts)>(rhs.tags_[i], [&](auto I)
+                    {
+                        this->template push_alternative<I>(std::get<I>(rhs.partitions_)[rhs.slots_[i]]);
+                    });
+                }
+            }
+            return *this;
+        }
+
+        partitioned_py_vector& append(std::initializer_list<value_type> new_values)
+        {
+            reserve_order(tags_.size() + new_values.size());
+            for (const auto& value : new_values)
+            {
+                push_value(value);
+            }
+            return *this;
+        }
+
+        template<typename T>
+        partitioned_py_vector& append(const T& element)
+        {
+            using alternative = mp11::mp_find<mp11::mp_list<Ts...>, T>;
+            static_assert(alternative::value < sizeof...(Ts), "Type T must be in type signature of py_vector.");
+
+            push_alternative<alternative::value>(element);
+            return *this;
+        }
+
+        // half open range
+
+        partitioned_py_vector& erase(std::size_t from, std::size_t to)
+        {
+            // because of our ordering invariant, the erased elements of each alternative
+            // are a contiguous run of slots in that alternative's partition.
+
+            std::array<std::size_t, sizeof...(Ts)> first_slot{};
+            std::array<std::size_t, sizeof...(Ts)> removed{};
+
+            for (std::size_t i = from; i < to; ++i)
+            {
+                if (removed[tags_[i]] == 0)
+                {
+                    first_slot[tags_[i]] = slots_[i];
+                }
+                ++removed[tags_[i]];
+            }
+
+            mp11::mp_for_each<mp11::mp_iota_c<sizeof...(Ts)>>([&](auto I)
+            {
+                if (removed[I] != 0)
+                {
+                    auto& partition = std::get<I>(partitions_);
+                    partition.erase(partition.begin() + first_slot[I], partition.begin() + first_slot[I] + removed[I]);
+                }
+            });
+
+            for (std::size_t i = to; i < tags_.size(); ++i)
+            {
+                slots_[i] -= static_cast<slot_type>(removed[tags_[i]]);
+            }
+
+            tags_.erase(tags_.begin() + from, tags_.begin() + to);
+            slots_.erase(slots_.begin() + from, slots_.begin() + to);
+            return *this;
+        }
+
+        /* ====================  OPERATORS     ======================================= */
+
+        partitioned_py_vector& operator=(const partitioned_py_vector& rhs) = default;
+        partitioned_py_vector& operator=(partitioned_py_vector&& rhs) noexcept = default;
+
+        template<typename ... Us>
+        partitioned_py_vector& operator=(const partitioned_py_vector<Us...>& rhs)
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>,
+                    "rhs py_vector type signature must be proper subset to copy assign.");
+
+            // a little bit of exception safety.
+
+            partitioned_py_vector new_values{rhs};
+            *this = std::move(new_values);
+            return *this;
+        }
+
+        partitioned_py_vector& operator+=(const partitioned_py_vector& rhs)
+        {
+            return this->append(rhs);
+        }
+
+        template<typename T>
+        partitioned_py_vector& operator+=(const T& element)
+        {
+            return this->append(element);
+        }
+
+        reference operator[](std::size_t index)
+        {
+            return reference{this, index};
+        }
+
+        value_type operator[](std::size_t index) const
+        {
+            return get_value(index);
+        }
+
+        // same type signature and same sequence of tags means each partition lines up
+        // with its counterpart so we can compare partition by partition.
+
+        bool operator==(const partitioned_py_vector& rhs) const
+        {
+            return tags_ == rhs.tags_ && partitions_ == rhs.partitions_;
+        }
+
+        template<typename ... Us>
+        bool operator==(const partitioned_py_vector<Us...>& rhs) const
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>,
+                    "rhs py_vector type signature must be proper subset to test equivalence.");
+
+            if (tags_.size() != rhs.tags_.size())
+            {
+                return false;
+            }
+            for (std::size_t i = 0; i < tags_.size(); ++i)
+            {
+                if (! element_equals(i, rhs, i))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template<typename S, typename ... Us>
+        bool operator==(const basic_py_vector<S, Us...>& rhs) const
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>,
+                    "rhs py_vector type signature must be proper subset to test equivalence.");
+
+            if (tags_.size() != rhs.size())
+            {
+                return false;
+            }
+            std::size_t i{0};
+            for (const auto& r_element : rhs)
+            {
+                if (! element_equals(i++, r_element))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    protected:
+        /* ====================  METHODS       ======================================= */
+
+        /* ====================  DATA MEMBERS  ======================================= */
+
+    private:
+        /* ====================  METHODS       ======================================= */
+
+        template<typename T, typename F>
+        void for_each_partition_of_type(F&& func)
+        {
+            using good_type = mp11::mp_contains<new_types_set_<Ts...>, T>;
+            static_assert(std::is_same_v<good_type, mp11::mp_true>, "Type T must be in type signature of py_vector.");
+
+            mp11::mp_for_each<mp11::mp_iota_c<sizeof...(Ts)>>([&](auto I)
+            {
+                if constexpr(std::is_same_v<T, std::variant_alternative_t<I, value_type>>)
+                {
+                    auto& partition = std::get<I>(partitions_);
+                    func(partition.data(), partition.size());
+                }
+            });
+        }
+
+        template<typename F>
+        void for_each_numeric_partition(F&& func) const
+        {
+            mp11::mp_for_each<mp11::mp_iota_c<sizeof...(Ts)>>([&](auto I)
+            {
+                if constexpr(cpp_like_py::is_py_numeric_v<std::variant_alternative_t<I, value_type>>)
+                {
+                    const auto& partition = std::get<I>(partitions_);
+                    if (! partition.empty())
+                    {
+                        func(I, partition.data(), partition.size());
+                    }
+                }
+            });
+        }
+
+        value_type get_value(std::size_t index) const
+        {
+            return mp11::mp_with_index<sizeof...(Ts)>(tags_.at(index), [&](auto I)
+            {
+                return value_type{std::in_place_index<I>, std::get<I>(partitions_)[slots_[index]]};
+            });
+        }
+
+        template<typename T>
+        std::size_t checked_slot(std::size_t index) const
+        {
+            if (tags_.at(index) != mp11::mp_find<mp11::mp_list<Ts...>, T>::value)
+            {
+                throw std::bad_variant_access{};
+            }
+            return slots_[index];
+        }
+
+        // compare our element at 'index' with a variant of any compatible type signature.
+
+        template<typename ...Us>
+        bool element_equals(std::size_t index, const std::variant<Us...>& rhs) const
+        {
+            bool result{false};
+            mp11::mp_with_index<sizeof...(Ts)>(tags_[index], [&](auto I)
+            {
+                using X = std::variant_alternative_t<I, value_type>;
+                const X& x = std::get<I>(partitions_)[slots_[index]];
+
+                mp11::mp_with_index<sizeof...(Us)>(rhs.index(), [&](auto J)
+                {
+                    using Y = std::variant_alternative_t<J, std::variant<Us...>>;
+                    if constexpr(std::is_same_v<X, Y>)
+                    {
+                        result = (x == std::get<J>(rhs));
+                    }
+                });
+            });
+            return result;
+        }
+
+        template<typename ...Us>
+        bool element_equals(std::size_t index, const partitioned_py_vector<Us...>& rhs, std::size_t rhs_index) const
+        {
+            bool result{false};
+            mp11::mp_with_index<sizeof...(Us)>(rhs.tags_[rhs_index], [&](auto J)
+            {
+                using Y = std::variant_alternative_t<J, std::variant<Us...>>;
+                const Y& y = std::get<J>(rhs.partitions_)[rhs.slots_[rhs_index]];
+
+                mp11::mp_with_index<sizeof...(Ts)>(tags_[index], [&](auto I)
+                {
+                    using X = std::variant_alternative_t<I, value_type>;
+                    if constexpr(std::is_same_v<X, Y>)
+                    {
+                        result = (std::get<I>(partitions_)[slots_[index]] == y);
+                    }
+                });
+            });
+            return result;
+        }
+
+        template<std::size_t I, typename X>
+        void push_alternative(X&& value)
+        {
+            auto& partition = std::get<I>(partitions_);
+            if (partition.size() >= std::numeric_limits<slot_type>::max())
+            {
+                throw std::length_error{"partitioned_py_vector: too many elements of one type."};
+            }
+            tags_.push_back(static_cast<tag_type>(I));
+            slots_.push_back(static_cast<slot_type>(partition.size()));
+            partition.push_back(std::forward<X>(value));
+        }
+
+        void push_value(const value_type& value)
+        {
+            mp11::mp_with_index<sizeof...(Ts)>(value.index(), [&](auto I)
+            {
+                this->template push_alternative<I>(std::get<I>(value));
+            });
+        }
+
+        // elements from a compatible type signature go in the first of our alternatives
+        // with the same type.
+
+        template<typename ...Us>
+        void push_foreign_value(const std::variant<Us...>& value)
+        {
+            using to_ours = cpp_like_py::alternative_translation<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>;
+
+            mp11::mp_with_index<sizeof...(Us)>(value.index(), [&](auto J)
+            {
+                this->template push_alternative<to_ours::value[J]>(std::get<J>(value));
+            });
+        }
+
+        // replace the element at 'index'.  Same alternative is an in place update.
+        // Otherwise, we have to move the element between partitions and keep our
+        // ordering invariant which costs a pass over the tail of the list.
+        //
+        // The new value goes into its partition before anything else changes so if that
+        // throws the list is as it was.
+
+        void assign_value(std::size_t index, value_type&& value)
+        {
+            const std::size_t old_tag = tags_.at(index);
+            const std::size_t new_tag = value.index();
+
+            if (old_tag == new_tag)
+            {
+                mp11::mp_with_index<sizeof...(Ts)>(new_tag, [&](auto I)
+                {
+                    std::get<I>(partitions_)[slots_[index]] = std::get<I>(std::move(value));
+                });
+                return;
+            }
+
+            // our new slot is the slot of the next element of the new alternative
+            // or the end of its partition if there isn't one.
+
+            std::size_t new_slot = mp11::mp_with_index<sizeof...(Ts)>(new_tag, [&](auto I)
+            {
+                return std::get<I>(partitions_).size();
+            });
+            if (new_slot >= std::numeric_limits<slot_type>::max())
+            {
+                throw std::length_error{"partitioned_py_vector: too many elements of one type."};
+            }
+            for (std::size_t i = index + 1; i < tags_.size(); ++i)
+            {
+                if (tags_[i] == new_tag)
+                {
+                    new_slot = slots_[i];
+                    break;
+                }
+            }
+
+            mp11::mp_with_index<sizeof...(Ts)>(new_tag, [&](auto I)
+            {
+                auto& partition = std::get<I>(partitions_);
+                partition.insert(partition.begin() + new_slot, std::get<I>(std::move(value)));
+            });
+            mp11::mp_with_index<sizeof...(Ts)>(old_tag, [&](auto I)
+            {
+                auto& partition = std::get<I>(partitions_);
+                partition.erase(partition.begin() + slots_[index]);
+            });
+
+            for (std::size_t i = index + 1; i < tags_.size(); ++i)
+            {
+                if (tags_[i] == old_tag)
+                {
+                    --slots_[i];
+                }
+                else if (tags_[i] == new_tag)
+                {
+                    ++slots_[i];
+                }
+            }
+            tags_[index] = static_cast<tag_type>(new_tag);
+            slots_[index] = static_cast<slot_type>(new_slot);
+        }
+
+        /* ====================  DATA MEMBERS  ======================================= */
+
+        partitions_t partitions_;
+        std::vector<tag_type> tags_;
+        std::vector<slot_type> slots_;
+
+}; /* ----------  end of template class partitioned_py_vector  ---------- */
+
+#endif   /* ----- #ifndef _PARTITIONED_PY_VECTOR_INC_  ----- */
@@ -0,0 +1,460 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  py_dict.h
+ *
+ *    Description:  python-like dict for C++17 built on an open addressing hash table.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 09:48:27 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  David P. Riedel (), driedel@cox.net
+ *   Organization:
+ *
+ * =====================================================================================
+ */
+
+
+#ifndef  _PY_DICT_INC_
+#define  _PY_DICT_INC_
+
+#include <utility>
+
+#include "py_hash_table.h"
+#include "py_vector.h"
+
+template<typename Keys, typename Values> class py_dict;
+
+/*
+ * =====================================================================================
+ *        Class:  py_dict
+ *  Description:  provides a Python-like dict class for C++
+ * =====================================================================================
+ */
+
+// Keys and values each have their own type signature:
+//
+//      py_dict<py_types<int, std::string>, py_types<float, std::string>> d{{1, 2.5F}, {"one", "uno"}};
+//
+// Like py_set, keys are looked up with a variant from a compatible type signature or
+// with a plain value such as an int or a std::string_view.  As in Python, iteration
+// is in the order keys were first inserted.
+
+template<typename ...Ks, typename ...Vs>
+class py_dict<mp11::mp_list<Ks...>, mp11::mp_list<Vs...>>
+{
+    public:
+
+        using key_type = std::variant<Ks...>;
+        using mapped_type = std::variant<Vs...>;
+
+        // what iteration gives.  Change 'value' all you like but leave 'key' and 'hash' alone.
+
+        struct item
+        {
+            std::size_t hash;
+            key_type key;
+            mapped_type value;
+        };
+
+        using value_type = item;
+        using table_t = cpp_like_py::flat_table<item>;
+        using iterator = typename table_t::iterator;
+        using const_iterator = typename table_t::const_iterator;
+
+        /* ====================  LIFECYCLE     ======================================= */
+        py_dict () = default;                                                /* constructor */
+        ~py_dict () = default;
+
+        py_dict (std::initializer_list<std::pair<key_type, mapped_type>> items)
+        {
+            table_.reserve(items.size());
+            for (const auto& [key, value] : items)
+            {
+                insert_or_assign(key, value);
+            }
+        }
+
+        py_dict(const py_dict& rhs) = default;
+        py_dict(py_dict&& rhs) noexcept = default;
+
+        template<typename ... Us, typename ... Ws>
+        py_dict(const py_dict<mp11::mp_list<Us...>, mp11::mp_list<Ws...>>& rhs)
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ks...>, mp11::mp_list<Us...>>,
+                    "rhs py_dict key type signature must be proper subset to copy construct.");
+            static_assert(types_are_subset_v<mp11::mp_list<Vs...>, mp11::mp_list<Ws...>>,
+                    "rhs py_dict value type signature must be proper subset to copy construct.");
+            update(rhs);
+        }
+
+        // Python's dict(zip(keys, values)).
+
+        template<typename S, typename ... Us, typename T, typename ... Ws>
+        py_dict(const basic_py_vector<S, Us...>& keys, const basic_py_vector<T, Ws...>& values)
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ks...>, mp11::mp_list<Us...>>,
+                    "keys py_vector type signature must be proper subset to construct.");
+            static_assert(types_are_subset_v<mp11::mp_list<Vs...>, mp11::mp_list<Ws...>>,
+                    "values py_vector type signature must be proper subset to construct.");
+
+            if (keys.size() != values.size())
+            {
+                throw std::invalid_argument{"py_dict: need the same number of keys and values."};
+            }
+            table_.reserve(keys.size());
+            auto value = values.begin();
+            for (const auto& key : keys)
+            {
+                insert_or_assign(key, *value);
+                ++value;
+            }
+        }
+
+        // Python's dict.fromkeys(keys, value).
+
+        template<typename S, typename ... Us, typename V = mapped_type>
+        [[nodiscard]] static py_dict fromkeys(const basic_py_vector<S, Us...>& keys, const V& value = {})
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ks...>, mp11::mp_list<Us...>>,
+                    "keys py_vector type signature must be proper subset to construct.");
+
+            py_dict result;
+            result.table_.reserve(keys.size());
+            for (const auto& key : keys)
+            {
+                result.insert_or_assign(key, value);
+            }
+            return result;
+        }
+
+        /* ====================  ACCESSORS     ======================================= */
+
+        auto size() const { return table_.size(); }
+        auto empty() const { return table_.empty(); }
+        const_iterator begin() const { return table_.begin(); }
+        const_iterator end() const { return table_.end(); }
+        iterator begin() { return table_.begin(); }
+        iterator end() { return table_.end(); }
+
+        template<typename Y>
+        bool contains(const Y& key) const
+        {
+            return find(key) != table_t::npos;
+        }
+
+        // nullptr if the key isn't there.  Lets you do what Python's d.get(k) does.
+
+        template<typename Y>
+        const mapped_type* get(const Y& key) const
+        {
+            const auto pos = find(key);
+            return pos == table_t::npos ? nullptr : &table_.entry(pos).value;
+        }
+
+        template<typename Y>
+        mapped_type* get(const Y& key)
+        {
+            const auto pos = find(key);
+            return pos == table_t::npos ? nullptr : &table_.entry(pos).value;
+        }
+
+        // Python's d[k] when reading: throws if the key isn't there.
+
+        template<typename Y>
+        const mapped_type& at(const Y& key) const
+        {
+            if (const auto* value = get(key))
+            {
+                return *value;
+            }
+            throw std::out_of_range{"py_dict: key not found."};
+        }
+
+        template<typename Y>
+        mapped_type& at(const Y& key)
+        {
+            if (auto* value = get(key))
+            {
+                return *value;
+            }
+            throw std::out_of_range{"py_dict: key not found."};
+        }
+
+        // Python's d.keys() and d.values(), as lists.
+
+        [[nodiscard]] py_vector<Ks...> keys() const
+        {
+            py_vector<Ks...> result;
+            result.reserve(table_.size());
+            for (const auto& e : table_)
+            {
+                std::visit([&result](const auto& x) { result.append(x); }, e.key);
+            }
+            return result;
+        }
+
+        [[nodiscard]] py_vector<Vs...> values() const
+        {
+            py_vector<Vs...> result;
+            result.reserve(table_.size());
+            for (const auto& e : table_)
+            {
+                std::visit([&result](const auto& x) { result.append(x); }, e.value);
+            }
+            return result;
+        }
+
+        void print_dict(std::ostream& out, const cpp_like_py::format_options& options = {}) const
+        {
+            auto& buffer = cpp_like_py::scratch_buffer();
+            format_to(buffer, options);
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        }
+
+        [[nodiscard]] std::string to_string(const cpp_like_py::format_options& options = {}) const
+        {
+            cpp_like_py::format_buffer buffer;
+            format_to(buffer, options);
+            return buffer.release();
+        }
+
+        // Python's format: {k: v, k: v}
+
+        void format_to(cpp_like_py::format_buffer& buffer, const cpp_like_py::format_options& options = {}) const
+        {
+            auto format_item([&buffer, &options](const auto& x) { cpp_like_py::format_value(buffer, x, options); });
+
+            buffer.append('{');
+            const char* separator = "";
+            for (const auto& e : table_)
+            {
+                buffer.append(separator);
+                std::visit(format_item, e.key);
+                buffer.append(": ");
+                std::visit(format_item, e.value);
+                separator = ", ";
+            }
+            buffer.append("}\n");
+        }
+
+        // this method will apply the supplied function to all values of the specified type.
+
+        template<typename T, class F>
+        void visit_values(F& func)
+        {
+            using good_type = mp11::mp_contains<new_types_set_<Vs...>, T>;
+            static_assert(std::is_same_v<good_type, mp11::mp_true>, "Type T must be in value type signature of py_dict.");
+
+            for (auto& e : table_)
+            {
+                if (auto* x = std::get_if<T>(&e.value))
+                {
+                    func(*x);
+                }
+            }
+        }
+
+        /* ====================  MUTATORS      ======================================= */
+
+        void reserve(std::size_t new_capacity) { table_.reserve(new_capacity); }
+        void clear() { table_.clear(); }
+
+        // Python's d[k] = v.  Returns true if the key is new.
+
+        template<typename Y, typename V>
+        bool insert_or_assign(Y&& key, V&& value)
+        {
+            const auto hash = cpp_like_py::key_hash(key);
+            const auto pos = table_.find(hash, [&key](const item& e) { return cpp_like_py::key_matches(e.key, key); });
+            if (pos != table_t::npos)
+            {
+                assign_mapped(table_.entry(pos).value, std::forward<V>(value));
+                return false;
+            }
+            mapped_type new_value;
+            assign_mapped(new_value, std::forward<V>(value));
+            table_.insert_new(hash, make_key(std::forward<Y>(key)), std::move(new_value));
+            return true;
+        }
+
+        // Python's d.setdefault(k, v): the value for 'key', after adding 'value' if
+        // the key wasn't there.
+
+        template<typename Y, typename V = mapped_type>
+        mapped_type& setdefault(Y&& key, V&& value = {})
+        {
+            const auto hash = cpp_like_py::key_hash(key);
+            auto pos = table_.find(hash, [&key](const item& e) { return cpp_like_py::key_matches(e.key, key); });
+            if (pos == table_t::npos)
+            {
+                mapped_type new_value;
+                assign_mapped(new_value, std::forward<V>(value));
+                pos = table_.insert_new(hash, make_key(std::forward<Y>(key)), std::move(new_value));
+            }
+            return table_.entry(pos).value;
+        }
+
+        // Python's d.update(other): add or replace everything in 'rhs'.
+
+        template<typename ... Us, typename ... Ws>
+        py_dict& update(const py_dict<mp11::mp_list<Us...>, mp11::mp_list<Ws...>>& rhs)
+        {
+            table_.reserve(table_.size() + rhs.size());
+            for (const auto& e : rhs)
+            {
+                insert_or_assign(e.key, e.value);
+            }
+            return *this;
+        }
+
+        // Python's d.pop(k) which raises KeyError if the key isn't there.
+
+        template<typename Y>
+        mapped_type pop(const Y& key)
+        {
+            const auto pos = find(key);
+            if (pos == table_t::npos)
+            {
+                throw std::out_of_range{"py_dict: key not found."};
+            }
+            mapped_type result{std::move(table_.entry(pos).value)};
+            table_.erase_at(pos);
+            return result;
+        }
+
+        // Python's del d[k] without the KeyError.  Returns true if it was there.
+
+        template<typename Y>
+        bool erase(const Y& key)
+        {
+            const auto pos = find(key);
+            if (pos == table_t::npos)
+            {
+                return false;
+            }
+            table_.erase_at(pos);
+            return true;
+        }
+
+        /* ====================  OPERATORS     ======================================= */
+
+        py_dict& operator=(const py_dict& rhs) = default;
+        py_dict& operator=(py_dict&& rhs) noexcept = default;
+
+        // the mutable version adds the key with an empty value if it isn't there, so
+        // d["x"] = 3 works.
+
+        template<typename Y>
+        mapped_type& operator[](Y&& key)
+        {
+            return setdefault(std::forward<Y>(key));
+        }
+
+        template<typename Y>
+        const mapped_type& operator[](const Y& key) const
+        {
+            return at(key);
+        }
+
+        // same keys with the same values, in any order.
+
+        template<typename ... Us, typename ... Ws>
+        bool operator==(const py_dict<mp11::mp_list<Us...>, mp11::mp_list<Ws...>>& rhs) const
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ks...>, mp11::mp_list<Us...>>,
+                    "rhs py_dict key type signature must be proper subset to test equivalence.");
+            static_assert(types_are_subset_v<mp11::mp_list<Vs...>, mp11::mp_list<Ws...>>,
+                    "rhs py_dict value type signature must be proper subset to test equivalence.");
+
+            if (size() != rhs.size())
+            {
+                return false;
+            }
+            for (const auto& e : rhs)
+            {
+                const auto* value = get(e.key);
+                if (value == nullptr || ! cpp_like_py::operator==(*value, e.value))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template<typename ... Us, typename ... Ws>
+        bool operator!=(const py_dict<mp11::mp_list<Us...>, mp11::mp_list<Ws...>>& rhs) const
+        {
+            return ! (*this == rhs);
+        }
+
+    protected:
+        /* ====================  METHODS       ======================================= */
+
+        /* ====================  DATA MEMBERS  ======================================= */
+
+    private:
+        /* ====================  METHODS       ======================================= */
+
+        template<typename Y>
+        std::size_t find(const Y& key) const
+        {
+            if constexpr(! cpp_like_py::is_variant_v<Y>)
+            {
+                static_assert(cpp_like_py::is_key_lookup_type_v<Y, Ks...>, "Type Y must be in key type signature of py_dict.");
+            }
+            return table_.find(cpp_like_py::key_hash(key), [&key](const item& e) { return cpp_like_py::key_matches(e.key, key); });
+        }
+
+        template<typename Y>
+        static key_type make_key(Y&& key)
+        {
+            using K = std::decay_t<Y>;
+            if constexpr(cpp_like_py::is_variant_v<K>)
+            {
+                return std::visit([](auto&& x) { return make_key(std::forward<decltype(x)>(x)); }, std::forward<Y>(key));
+            }
+            else if constexpr(mp11::mp_contains<mp11::mp_list<Ks...>, K>::value)
+            {
+                return key_type(std::in_place_index<mp11::mp_find<mp11::mp_list<Ks...>, K>::value>, std::forward<Y>(key));
+            }
+            else
+            {
+                static_assert(cpp_like_py::is_key_lookup_type_v<K, Ks...>, "Type Y must be in key type signature of py_dict.");
+                return key_type(std::in_place_index<mp11::mp_find<mp11::mp_list<Ks...>, std::string>::value>, std::string_view{key});
+            }
+        }
+
+        // values from another type signature go in the first of our alternatives with the same type.
+
+        template<typename V>
+        static void assign_mapped(mapped_type& to, V&& value)
+        {
+            using W = std::decay_t<V>;
+            if constexpr(std::is_same_v<W, mapped_type>)
+            {
+                to = std::forward<V>(value);
+            }
+            else if constexpr(cpp_like_py::is_variant_v<W>)
+            {
+                std::visit([&to](auto&& x) { assign_mapped(to, std::forward<decltype(x)>(x)); }, std::forward<V>(value));
+            }
+            else if constexpr(mp11::mp_contains<mp11::mp_list<Vs...>, W>::value)
+            {
+                to.template emplace<mp11::mp_find<mp11::mp_list<Vs...>, W>::value>(std::forward<V>(value));
+            }
+            else
+            {
+                to = mapped_type(std::forward<V>(value));
+            }
+        }
+
+        /* ====================  DATA MEMBERS  ======================================= */
+
+        table_t table_;
+
+}; /* ----------  end of template class py_dict  ---------- */
+
+#endif   /* ----- #ifndef _PY_DICT_INC_  ----- */
@@ -0,0 +1,263 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  py_format.h
+ *
+ *    Description:  fast text output for py_vector and friends.  Numbers go through
+ *                  std::to_chars into a reusable buffer instead of an ostream.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 06:21:09 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  David P. Riedel (), driedel@cox.net
+ *   Organization:
+ *
+ * =====================================================================================
+ */
+
+
+#ifndef  _PY_FORMAT_INC_
+#define  _PY_FORMAT_INC_
+
+#include <cerrno>
+#include <charconv>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <variant>
+
+#include <unistd.h>
+
+namespace cpp_like_py
+{
+    // 'repr' quotes strings and chars the way Python's repr() does and shows bools
+    // as True and False.  Otherwise output is exactly what operator<< gives.
+
+    struct format_options
+    {
+        bool repr = false;
+    };
+
+    /*
+     * =====================================================================================
+     *        Class:  format_buffer
+     *  Description:  growable text buffer.  clear() keeps the memory for next time.
+     * =====================================================================================
+     */
+
+    class format_buffer
+    {
+        public:
+
+            void append(char c) { text_.push_back(c); }
+            void append(std::string_view s) { text_.append(s.data(), s.size()); }
+
+            void clear() { text_.clear(); }
+            void reserve(std::size_t new_capacity) { text_.reserve(new_capacity); }
+
+            const char* data() const { return text_.data(); }
+            std::size_t size() const { return text_.size(); }
+            std::string_view view() const { return text_; }
+
+            // hand over the text.  The buffer is left empty.
+
+            std::string release() { return std::move(text_); }
+
+        private:
+
+            std::string text_;
+    };
+
+    // writes everything, however many calls to write() it takes.
+
+    inline void write_all(int fd, const char* data, std::size_t size)
+    {
+        while (size != 0)
+        {
+            const auto written = ::write(fd, data, size);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throw std::system_error{errno, std::generic_category(), "write failed."};
+            }
+            data += written;
+            size -= static_cast<std::size_t>(written);
+        }
+    }
+
+    template<typename T, typename = void>
+    struct is_ostreamable : std::false_type { };
+
+    template<typename T>
+    struct is_ostreamable<T, std::void_t<decltype(std::declval<std::ostream&>() << std::declval<const T&>())>> : std::true_type { };
+
+    inline void format_quoted(format_buffer& buffer, std::string_view s)
+    {
+        // same choice of quotes as Python.
+
+        const char quote = (s.find('\'') != std::string_view::npos && s.find('"') == std::string_view::npos) ? '"' : '\'';
+        constexpr char hex_digits[] = "0123456789abcdef";
+
+        buffer.append(quote);
+        for (const char c : s)
+        {
+            switch (c)
+            {
+                case '\\': buffer.append("\\\\"); break;
+                case '\n': buffer.append("\\n"); break;
+                case '\r': buffer.append("\\r"); break;
+                case '\t': buffer.append("\\t"); break;
+                default:
+                    if (c == quote)
+                    {
+                        buffer.append('\\');
+                        buffer.append(c);
+                    }
+                    else if (static_cast<unsigned char>(c) < 0x20 || c == 0x7f)
+                    {
+                        const auto u = static_cast<unsigned char>(c);
+                        const char escaped[] = {'\\', 'x', hex_digits[u >> 4], hex_digits[u & 0x0f]};
+                        buffer.append(std::string_view{escaped, sizeof(escaped)});
+                    }
+                    else
+                    {
+                        buffer.append(c);
+                    }
+            }
+        }
+        buffer.append(quote);
+    }
+
+    // one value.  The common alternatives have their own fast path.  Anything else
+    // which has an operator<< still works, just at ostream speed.
+
+    template<typename T>
+    void format_value(format_buffer& buffer, const T& value, const format_options& options)
+    {
+        if constexpr(std::is_same_v<T, bool>)
+        {
+            buffer.append(options.repr ? (value ? "True" : "False") : (value ? "1" : "0"));
+        }
+        else if constexpr(std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>)
+        {
+            if (options.repr)
+            {
+                const char c = static_cast<char>(value);
+                format_quoted(buffer, std::string_view{&c, 1});
+            }
+            else
+            {
+                buffer.append(static_cast<char>(value));
+            }
+        }
+        else if constexpr(std::is_integral_v<T>)
+        {
+            char digits[24];
+            const auto result = std::to_chars(std::begin(digits), std::end(digits), value);
+            buffer.append(std::string_view{digits, static_cast<std::size_t>(result.ptr - digits)});
+        }
+        else if constexpr(std::is_floating_point_v<T>)
+        {
+            // an ostream's default is %g with 6 significant digits.
+
+            char digits[64];
+            const auto result = std::to_chars(std::begin(digits), std::end(digits), value, std::chars_format::general, 6);
+            buffer.append(std::string_view{digits, static_cast<std::size_t>(result.ptr - digits)});
+        }
+        else if constexpr(std::is_convertible_v<const T&, std::string_view>)
+        {
+            if (options.repr)
+            {
+                format_quoted(buffer, value);
+            }
+            else
+            {
+                buffer.append(std::string_view{value});
+            }
+        }
+        else
+        {
+            static_assert(is_ostreamable<T>::value, "Type T has no operator<< so it can't be formatted.");
+            std::ostringstream out;
+            out << value;
+            buffer.append(out.str());
+        }
+    }
+
+    // writes elements in our list format: [a, b, c]
+    // after each element, 'full' gets a look at the buffer so it can flush it.
+
+    template<typename Iterator, typename Full>
+    void format_elements(format_buffer& buffer, Iterator first, Iterator last, const format_options& options, Full&& full)
+    {
+        auto format_item([&buffer, &options](const auto& e) { format_value(buffer, e, options); });
+
+        buffer.append('[');
+
+        if (first != last)
+        {
+            std::visit(format_item, *first);
+            full(buffer);
+            for(++first; first != last; ++first)
+            {
+                buffer.append(", ");
+                std::visit(format_item, *first);
+                full(buffer);
+            }
+        }
+        buffer.append("]\n");
+    }
+
+    template<typename Iterator>
+    void format_elements(format_buffer& buffer, Iterator first, Iterator last, const format_options& options = {})
+    {
+        format_elements(buffer, first, last, options, [](format_buffer&) { });
+    }
+
+    // for printing to a stream.  Each thread keeps its buffer so after the first list
+    // we don't allocate at all.
+
+    inline format_buffer& scratch_buffer()
+    {
+        thread_local format_buffer buffer;
+        buffer.clear();
+        return buffer;
+    }
+
+    template<typename Iterator>
+    void print_elements(std::ostream& out, Iterator first, Iterator last, const format_options& options = {})
+    {
+        auto& buffer = scratch_buffer();
+        format_elements(buffer, first, last, options);
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    }
+
+    // straight to a file descriptor in blocks of about 'block_size' bytes.
+
+    template<typename Iterator>
+    void write_elements(int fd, Iterator first, Iterator last, const format_options& options = {}, std::size_t block_size = 64 * 1024)
+    {
+        auto& buffer = scratch_buffer();
+        buffer.reserve(block_size + block_size / 4);
+        format_elements(buffer, first, last, options, [fd, block_size](format_buffer& buffer)
+        {
+            if (buffer.size() >= block_size)
+            {
+                write_all(fd, buffer.data(), buffer.size());
+                buffer.clear();
+            }
+        });
+        write_all(fd, buffer.data(), buffer.size());
+        buffer.clear();
+    }
+}		/* -----  end of namespace cpp_like_py  ----- */
+
+#endif   /* ----- #ifndef _PY_FORMAT_INC_  ----- */
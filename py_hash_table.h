@@ -0,0 +1,351 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  py_hash_table.h
+ *
+ *    Description:  open addressing hash table shared by py_set and py_dict plus the
+ *                  hashing and key matching which let them look up plain values.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 09:48:27 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  David P. Riedel (), driedel@cox.net
+ *   Organization:
+ *
+ * =====================================================================================
+ */
+
+
+#ifndef  _PY_HASH_TABLE_INC_
+#define  _PY_HASH_TABLE_INC_
+
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include <boost/mp11.hpp>
+
+namespace mp11 = boost::mp11;
+
+// names a type signature where a class needs more than one, py_dict<py_types<...>, py_types<...>>.
+
+template<typename ...Ts>
+using py_types = mp11::mp_list<Ts...>;
+
+namespace cpp_like_py
+{
+    // keys which hold a std::string can be looked up with anything that converts
+    // to a std::string_view, without making a std::string first.
+
+    template<typename Y>
+    inline constexpr bool is_string_like_v = std::is_convertible_v<const Y&, std::string_view>;
+
+    template<typename Y, typename ...Ts>
+    inline constexpr bool is_key_lookup_type_v = mp11::mp_contains<mp11::mp_list<Ts...>, Y>::value
+        || (is_string_like_v<Y> && mp11::mp_contains<mp11::mp_list<Ts...>, std::string>::value);
+
+    // std::hash of an int is the int.  Spread the bits out since we only use the
+    // low ones to pick a slot.
+
+    inline std::size_t mix_hash(std::uint64_t h)
+    {
+        h ^= h >> 32;
+        h *= 0x9e3779b97f4a7c15ULL;
+        h ^= h >> 29;
+        return static_cast<std::size_t>(h);
+    }
+
+    // the hash of a key only depends on its value, not on which alternative holds it.
+    // So a plain int or a string_view hashes the same as a variant holding one.
+
+    template<typename T>
+    std::size_t key_hash(const T& value)
+    {
+        if constexpr(is_string_like_v<T>)
+        {
+            return mix_hash(std::hash<std::string_view>{}(std::string_view{value}));
+        }
+        else
+        {
+            return mix_hash(std::hash<T>{}(value));
+        }
+    }
+
+    template<typename ...Ts>
+    std::size_t key_hash(const std::variant<Ts...>& key)
+    {
+        return std::visit([](const auto& x) { return key_hash(x); }, key);
+    }
+
+    // like holds_equal() but strings also match anything string like.
+
+    template<typename ...Ts, typename Y>
+    bool key_matches(const std::variant<Ts...>& key, const Y& item)
+    {
+        bool result{false};
+        mp11::mp_with_index<sizeof...(Ts)>(key.index(), [&](auto I)
+        {
+            using X = std::variant_alternative_t<I, std::variant<Ts ...>>;
+            if constexpr(std::is_same_v<X, Y>)
+            {
+                result = (std::get<I>(key) == item);
+            }
+            else if constexpr(std::is_same_v<X, std::string> && is_string_like_v<Y>)
+            {
+                result = (std::string_view{std::get<I>(key)} == std::string_view{item});
+            }
+        });
+        return result;
+    }
+
+    template<typename ...Ts, typename ...Us>
+    bool key_matches(const std::variant<Ts...>& key, const std::variant<Us...>& item)
+    {
+        return std::visit([&key](const auto& y) { return key_matches(key, y); }, item);
+    }
+
+    /*
+     * =====================================================================================
+     *        Class:  flat_table
+     *  Description:  open addressing hash index over a dense vector of entries kept in
+     *                insertion order, the way Python's own dict is laid out.
+     * =====================================================================================
+     */
+
+    // 'Entry' is an aggregate whose first member is 'std::size_t hash'.  The table
+    // never looks at anything else, finding a key is up to the 'equals' function the
+    // caller passes along.
+    //
+    // The index is a power of 2 array of entry positions probed linearly.  We compare
+    // the stored hashes before calling 'equals' so most misses never touch a key.
+    // Erased entries stay in place, marked, until the next time the index is rebuilt.
+
+    template<typename Entry>
+    class flat_table
+    {
+        public:
+
+            static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+            template<bool Const>
+            class basic_iterator
+            {
+                public:
+
+                    using iterator_category = std::forward_iterator_tag;
+                    using value_type = Entry;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = std::conditional_t<Const, const Entry*, Entry*>;
+                    using reference = std::conditional_t<Const, const Entry&, Entry&>;
+                    using table_t = std::conditional_t<Const, const flat_table, flat_table>;
+
+                    basic_iterator() = default;
+                    basic_iterator(table_t* table, std::size_t pos) : table_{table}, pos_{pos} { skip_erased(); }
+
+                    reference operator*() const { return table_->entries_[pos_]; }
+                    pointer operator->() const { return &table_->entries_[pos_]; }
+
+                    basic_iterator& operator++() { ++pos_; skip_erased(); return *this; }
+                    basic_iterator operator++(int) { auto result{*this}; ++*this; return result; }
+
+                    bool operator==(const basic_iterator& rhs) const { return pos_ == rhs.pos_; }
+                    bool operator!=(const basic_iterator& rhs) const { return pos_ != rhs.pos_; }
+
+                private:
+
+                    void skip_erased()
+                    {
+                        while (pos_ < table_->entries_.size() && table_->erased_[pos_])
+                        {
+                            ++pos_;
+                        }
+                    }
+
+                    table_t* table_ = nullptr;
+                    std::size_t pos_ = 0;
+            };
+
+            using iterator = basic_iterator<false>;
+            using const_iterator = basic_iterator<true>;
+
+            /* ====================  ACCESSORS     ======================================= */
+
+            std::size_t size() const { return live_; }
+            bool empty() const { return live_ == 0; }
+
+            iterator begin() { return {this, 0}; }
+            iterator end() { return {this, entries_.size()}; }
+            const_iterator begin() const { return {this, 0}; }
+            const_iterator end() const { return {this, entries_.size()}; }
+
+            Entry& entry(std::size_t pos) { return entries_[pos]; }
+            const Entry& entry(std::size_t pos) const { return entries_[pos]; }
+
+            // position of the entry with this hash which 'equals' accepts or npos.
+
+            template<typename Equals>
+            std::size_t find(std::size_t hash, Equals&& equals) const
+            {
+                if (slots_.empty())
+                {
+                    return npos;
+                }
+                const std::size_t mask = slots_.size() - 1;
+                for (std::size_t i = hash & mask; ; i = (i + 1) & mask)
+                {
+                    const auto slot = slots_[i];
+                    if (slot == empty_slot)
+                    {
+                        return npos;
+                    }
+                    if (slot != erased_slot && entries_[slot].hash == hash && equals(entries_[slot]))
+                    {
+                        return slot;
+                    }
+                }
+            }
+
+            /* ====================  MUTATORS      ======================================= */
+
+            void reserve(std::size_t count)
+            {
+                if (slots_for(count) > slots_.size())
+                {
+                    rebuild(slots_for(count));
+                }
+                entries_.reserve(count);
+            }
+
+            void clear()
+            {
+                entries_.clear();
+                erased_.clear();
+                slots_.clear();
+                live_ = 0;
+            }
+
+            // the position of a matching entry or of the new one made from 'hash, args...'.
+            // The bool is true if we made one.
+
+            template<typename Equals, typename ...Args>
+            std::pair<std::size_t, bool> insert(std::size_t hash, Equals&& equals, Args&&... args)
+            {
+                if (const auto pos = find(hash, equals); pos != npos)
+                {
+                    return {pos, false};
+                }
+                return {insert_new(hash, std::forward<Args>(args)...), true};
+            }
+
+            // for when the caller has already looked and knows there is no match.
+
+            template<typename ...Args>
+            std::size_t insert_new(std::size_t hash, Args&&... args)
+            {
+                if ((entries_.size() + 1) * 4 > slots_.size() * 3)
+                {
+                    rebuild(slots_for(live_ + 1));
+                }
+                if (entries_.size() >= erased_slot)
+                {
+                    throw std::length_error{"flat_table: too many entries."};
+                }
+
+                entries_.push_back(Entry{hash, std::forward<Args>(args)...});
+                erased_.push_back(false);
+                place(hash, entries_.size() - 1);
+                ++live_;
+                return entries_.size() - 1;
+            }
+
+            void erase_at(std::size_t pos)
+            {
+                const std::size_t mask = slots_.size() - 1;
+                for (std::size_t i = entries_[pos].hash & mask; ; i = (i + 1) & mask)
+                {
+                    if (slots_[i] == pos)
+                    {
+                        slots_[i] = erased_slot;
+                        break;
+                    }
+                }
+                erased_[pos] = true;
+                --live_;
+            }
+
+        private:
+
+            using slot_type = std::uint32_t;
+
+            static constexpr slot_type empty_slot = std::numeric_limits<slot_type>::max();
+            static constexpr slot_type erased_slot = empty_slot - 1;
+
+            // at most 3/4 full after 'count' entries.
+
+            static std::size_t slots_for(std::size_t count)
+            {
+                std::size_t result{16};
+                while (result * 3 < count * 4)
+                {
+                    result *= 2;
+                }
+                return result;
+            }
+
+            void place(std::size_t hash, std::size_t pos)
+            {
+                const std::size_t mask = slots_.size() - 1;
+                std::size_t i = hash & mask;
+                while (slots_[i] != empty_slot)
+                {
+                    i = (i + 1) & mask;
+                }
+                slots_[i] = static_cast<slot_type>(pos);
+            }
+
+            // squeeze out erased entries, keeping the order of the rest, and index them again.
+
+            void rebuild(std::size_t slot_count)
+            {
+                if (live_ != entries_.size())
+                {
+                    std::size_t to{0};
+                    for (std::size_t from = 0; from < entries_.size(); ++from)
+                    {
+                        if (! erased_[from])
+                        {
+                            if (to != from)
+                            {
+                                entries_[to] = std::move(entries_[from]);
+                            }
+                            ++to;
+                        }
+                    }
+                    entries_.erase(entries_.begin() + to, entries_.end());
+                    erased_.assign(entries_.size(), false);
+                }
+
+                slots_.assign(slot_count, empty_slot);
+                for (std::size_t pos = 0; pos < entries_.size(); ++pos)
+                {
+                    place(entries_[pos].hash, pos);
+                }
+            }
+
+            std::vector<Entry> entries_;
+            std::vector<bool> erased_;
+            std::vector<slot_type> slots_;
+            std::size_t live_ = 0;
+    };
+}		/* -----  end of namespace cpp_like_py  ----- */
+
+#endif   /* ----- #ifndef _PY_HASH_TABLE_INC_  ----- */
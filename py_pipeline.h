@@ -0,0 +1,620 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  py_pipeline.h
+ *
+ *    Description:  lazy of_type, filter, map, enumerate and zip over py_vector
+ *                  (or anything with iterators).  Nothing is built until the end.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 07:02:44 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  David P. Riedel (), driedel@cox.net
+ *   Organization:
+ *
+ * =====================================================================================
+ */
+
+
+#ifndef  _PY_PIPELINE_INC_
+#define  _PY_PIPELINE_INC_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <boost/mp11.hpp>
+
+struct vector_storage;
+
+template<typename Storage, typename ...Ts>
+class basic_py_vector;
+
+// Each stage holds the stage before it and its own function and its iterators pull
+// elements through all the stages at once, so a pipeline is one pass over the list
+// no matter how many stages it has.
+//
+//  auto lengths = of_type<std::string>(x).filter(not_empty).map(length).to_vector();
+//
+// A pipeline looks at the list it was made from so it must not outlive it.  Stages
+// are copied into the next stage so they can be built up in pieces and reused.
+
+namespace cpp_like_py
+{
+    // pointer to the T in 'elem' or nullptr.  Any alternative of type T will do.
+
+    template<typename T, typename Variant>
+    auto get_if_type(Variant* elem)
+    {
+        using result_t = std::conditional_t<std::is_const_v<Variant>, const T*, T*>;
+        result_t result{nullptr};
+        boost::mp11::mp_with_index<std::variant_size_v<std::remove_const_t<Variant>>>(elem->index(), [&](auto I)
+        {
+            if constexpr(std::is_same_v<std::variant_alternative_t<I, std::remove_const_t<Variant>>, T>)
+            {
+                result = std::get_if<I>(elem);
+            }
+        });
+        return result;
+    }
+
+    template<typename Source, typename Pred> class filter_range;
+    template<typename Source, typename F> class map_range;
+    template<typename Source> class enumerate_range;
+    template<typename A, typename B> class zip_range;
+
+    template<typename Iterable> auto all(Iterable& iterable);
+    template<typename T> struct is_pipeline;
+
+    /*
+     * =====================================================================================
+     *        Class:  pipeline
+     *  Description:  what every stage can do.  'Derived' supplies begin(), end()
+     *                and size_hint().
+     * =====================================================================================
+     */
+
+    // size_hint() is how many elements we might produce.  It is exact unless there is
+    // a filter in the pipeline and is what the to_ methods reserve so they allocate once.
+
+    template<typename Derived>
+    class pipeline
+    {
+        public:
+
+            template<typename Pred>
+            auto filter(Pred pred) const { return filter_range<Derived, Pred>{derived(), std::move(pred)}; }
+
+            template<typename F>
+            auto map(F func) const { return map_range<Derived, F>{derived(), std::move(func)}; }
+
+            auto enumerate(std::size_t start = 0) const { return enumerate_range<Derived>{derived(), start}; }
+
+            // 'other' can be a pipeline or a list.  A list is only looked at, not copied.
+
+            template<typename Other>
+            auto zip(Other&& other) const
+            {
+                static_assert(is_pipeline<std::decay_t<Other>>::value || std::is_lvalue_reference_v<Other>,
+                        "zip needs a pipeline or a list which will outlive it.");
+                return zip_range<Derived, decltype(all(other))>{derived(), all(other)};
+            }
+
+            /* ====================  TERMINALS     ======================================= */
+
+            // collect into a std::vector.  T defaults to the type of the elements.
+
+            template<typename T = void>
+            auto to_vector() const
+            {
+                using element_t = std::decay_t<decltype(*derived().begin())>;
+                using value_t = std::conditional_t<std::is_void_v<T>, element_t, T>;
+
+                std::vector<value_t> result;
+                result.reserve(derived().size_hint());
+                for (auto&& elem : derived())
+                {
+                    result.emplace_back(std::forward<decltype(elem)>(elem));
+                }
+                return result;
+            }
+
+            // collect into any py_vector.  Elements can be plain values or variants
+            // whose types are all in the list's type signature.
+
+            template<typename List>
+            List to_list() const
+            {
+                List result;
+                result.reserve(derived().size_hint());
+                for (auto&& elem : derived())
+                {
+                    if constexpr(is_variant_value<decltype(elem)>::value)
+                    {
+                        std::visit([&result](auto&& value) { result.append(std::forward<decltype(value)>(value)); },
+                                std::forward<decltype(elem)>(elem));
+                    }
+                    else
+                    {
+                        result.append(std::forward<decltype(elem)>(elem));
+                    }
+                }
+                return result;
+            }
+
+            template<typename ...Us>
+            basic_py_vector<vector_storage, Us...> to_py_vector() const
+            {
+                return to_list<basic_py_vector<vector_storage, Us...>>();
+            }
+
+        private:
+
+            template<typename T>
+            struct is_variant_value : std::false_type { };
+
+            template<typename ...Vs>
+            struct is_variant_value<std::variant<Vs...>> : std::true_type { };
+
+            template<typename T>
+            struct is_variant_value<T&> : is_variant_value<std::remove_const_t<T>> { };
+
+            template<typename T>
+            struct is_variant_value<T&&> : is_variant_value<std::remove_const_t<T>> { };
+
+            const Derived& derived() const { return static_cast<const Derived&>(*this); }
+    };
+
+    /*
+     * =====================================================================================
+     *        Class:  iterator_range
+     *  Description:  the start of a pipeline: just a pair of iterators.
+     * =====================================================================================
+     */
+
+    template<typename Iterator>
+    class iterator_range : public pipeline<iterator_range<Iterator>>
+    {
+        public:
+
+            using iterator = Iterator;
+
+            iterator_range(Iterator first, Iterator last) : first_{first}, last_{last} { }
+
+            Iterator begin() const { return first_; }
+            Iterator end() const { return last_; }
+            std::size_t size_hint() const { return static_cast<std::size_t>(std::distance(first_, last_)); }
+
+        private:
+
+            Iterator first_;
+            Iterator last_;
+    };
+
+    /*
+     * =====================================================================================
+     *        Class:  of_type_range
+     *  Description:  the elements of type T from a range of variants, as T&.
+     * =====================================================================================
+     */
+
+    template<typename T, typename Iterator>
+    class of_type_range : public pipeline<of_type_range<T, Iterator>>
+    {
+        using variant_t = std::remove_reference_t<typename std::iterator_traits<Iterator>::reference>;
+
+        public:
+
+            using element_reference = std::conditional_t<std::is_const_v<variant_t>, const T&, T&>;
+
+            class iterator
+            {
+                public:
+
+                    using iterator_category = std::forward_iterator_tag;
+                    using value_type = T;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = std::remove_reference_t<element_reference>*;
+                    using reference = of_type_range::element_reference;
+
+                    iterator() = default;
+                    iterator(Iterator current, Iterator last) : current_{current}, last_{last} { skip(); }
+
+                    reference operator*() const { return *get_if_type<T>(&*current_); }
+                    pointer operator->() const { return get_if_type<T>(&*current_); }
+
+                    iterator& operator++() { ++current_; skip(); return *this; }
+                    iterator operator++(int) { auto result{*this}; ++*this; return result; }
+
+                    bool operator==(const iterator& rhs) const { return current_ == rhs.current_; }
+                    bool operator!=(const iterator& rhs) const { return current_ != rhs.current_; }
+
+                private:
+
+                    void skip()
+                    {
+                        while (current_ != last_ && get_if_type<T>(&*current_) == nullptr)
+                        {
+                            ++current_;
+                        }
+                    }
+
+                    Iterator current_{};
+                    Iterator last_{};
+            };
+
+            of_type_range(Iterator first, Iterator last, std::optional<std::size_t> count = {})
+                : first_{first}, last_{last}, count_{count} { }
+
+            iterator begin() const { return iterator{first_, last_}; }
+            iterator end() const { return iterator{last_, last_}; }
+
+            // a whole py_vector tells us how many T's it has.  Otherwise, we don't make
+            // an extra pass to find out and the size of the range is the upper bound.
+
+            std::size_t size_hint() const
+            {
+                if (count_)
+                {
+                    return *count_;
+                }
+                return static_cast<std::size_t>(std::distance(first_, last_));
+            }
+
+        private:
+
+            Iterator first_;
+            Iterator last_;
+            std::optional<std::size_t> count_;
+    };
+
+    /*
+     * =====================================================================================
+     *        Class:  filter_range
+     *  Description:  Python's filter(pred, iterable).
+     * =====================================================================================
+     */
+
+    template<typename Source, typename Pred>
+    class filter_range : public pipeline<filter_range<Source, Pred>>
+    {
+        using source_iterator = decltype(std::declval<const Source&>().begin());
+        using source_reference = decltype(*std::declval<source_iterator>());
+
+        // if the stage before us makes its elements (a map for example) we keep the one
+        // pred looked at rather than make it again.
+
+        static constexpr bool cache_ = ! std::is_lvalue_reference_v<source_reference>;
+
+        public:
+
+            using value_type = std::decay_t<source_reference>;
+            using element_reference = std::conditional_t<cache_, const value_type&, source_reference>;
+
+            class iterator
+            {
+                public:
+
+                    using iterator_category = std::forward_iterator_tag;
+                    using value_type = filter_range::value_type;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = std::remove_reference_t<element_reference>*;
+                    using reference = filter_range::element_reference;
+
+                    iterator() = default;
+                    iterator(source_iterator current, source_iterator last, const Pred* pred)
+                        : current_{current}, last_{last}, pred_{pred} { skip(); }
+
+                    reference operator*() const
+                    {
+                        if constexpr(cache_)
+                        {
+                            return *cached_;
+                        }
+                        else
+                        {
+                            return *current_;
+                        }
+                    }
+
+                    iterator& operator++() { ++current_; skip(); return *this; }
+                    iterator operator++(int) { auto result{*this}; ++*this; return result; }
+
+                    bool operator==(const iterator& rhs) const { return current_ == rhs.current_; }
+                    bool operator!=(const iterator& rhs) const { return current_ != rhs.current_; }
+
+                private:
+
+                    void skip()
+                    {
+                        for (; current_ != last_; ++current_)
+                        {
+                            if constexpr(cache_)
+                            {
+                                cached_.emplace(*current_);
+                                if ((*pred_)(*cached_))
+                                {
+                                    return;
+                                }
+                            }
+                            else
+                            {
+                                if ((*pred_)(*current_))
+                                {
+                                    return;
+                                }
+                            }
+                        }
+                    }
+
+                    source_iterator current_{};
+                    source_iterator last_{};
+                    const Pred* pred_ = nullptr;
+                    std::conditional_t<cache_, std::optional<value_type>, std::monostate> cached_;
+            };
+
+            filter_range(Source source, Pred pred) : source_{std::move(source)}, pred_{std::move(pred)} { }
+
+            iterator begin() const { return iterator{source_.begin(), source_.end(), &pred_}; }
+            iterator end() const { return iterator{source_.end(), source_.end(), &pred_}; }
+            std::size_t size_hint() const { return source_.size_hint(); }
+
+        private:
+
+            Source source_;
+            Pred pred_;
+    };
+
+    /*
+     * =====================================================================================
+     *        Class:  map_range
+     *  Description:  Python's map(func, iterable).
+     * =====================================================================================
+     */
+
+    template<typename Source, typename F>
+    class map_range : public pipeline<map_range<Source, F>>
+    {
+        using source_iterator = decltype(std::declval<const Source&>().begin());
+
+        public:
+
+            using element_reference = std::invoke_result_t<const F&, decltype(*std::declval<source_iterator>())>;
+
+            class iterator
+            {
+                public:
+
+                    using iterator_category = std::forward_iterator_tag;
+                    using value_type = std::decay_t<element_reference>;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = void;
+                    using reference = map_range::element_reference;
+
+                    iterator() = default;
+                    iterator(source_iterator current, const F* func) : current_{current}, func_{func} { }
+
+                    reference operator*() const { return (*func_)(*current_); }
+
+                    iterator& operator++() { ++current_; return *this; }
+                    iterator operator++(int) { auto result{*this}; ++current_; return result; }
+
+                    bool operator==(const iterator& rhs) const { return current_ == rhs.current_; }
+                    bool operator!=(const iterator& rhs) const { return current_ != rhs.current_; }
+
+                private:
+
+                    source_iterator current_{};
+                    const F* func_ = nullptr;
+            };
+
+            map_range(Source source, F func) : source_{std::move(source)}, func_{std::move(func)} { }
+
+            iterator begin() const { return iterator{source_.begin(), &func_}; }
+            iterator end() const { return iterator{source_.end(), &func_}; }
+            std::size_t size_hint() const { return source_.size_hint(); }
+
+        private:
+
+            Source source_;
+            F func_;
+    };
+
+    /*
+     * =====================================================================================
+     *        Class:  enumerate_range
+     *  Description:  Python's enumerate(iterable, start).  Gives (count, element) pairs.
+     * =====================================================================================
+     */
+
+    template<typename Source>
+    class enumerate_range : public pipeline<enumerate_range<Source>>
+    {
+        using source_iterator = decltype(std::declval<const Source&>().begin());
+
+        public:
+
+            using element_reference = std::pair<std::size_t, decltype(*std::declval<source_iterator>())>;
+
+            class iterator
+            {
+                public:
+
+                    using iterator_category = std::forward_iterator_tag;
+                    using value_type = element_reference;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = void;
+                    using reference = enumerate_range::element_reference;
+
+                    iterator() = default;
+                    iterator(source_iterator current, std::size_t count) : current_{current}, count_{count} { }
+
+                    reference operator*() const { return reference{count_, *current_}; }
+
+                    iterator& operator++() { ++current_; ++count_; return *this; }
+                    iterator operator++(int) { auto result{*this}; ++*this; return result; }
+
+                    bool operator==(const iterator& rhs) const { return current_ == rhs.current_; }
+                    bool operator!=(const iterator& rhs) const { return current_ != rhs.current_; }
+
+                private:
+
+                    source_iterator current_{};
+                    std::size_t count_ = 0;
+            };
+
+            enumerate_range(Source source, std::size_t start) : source_{std::move(source)}, start_{start} { }
+
+            iterator begin() const { return iterator{source_.begin(), start_}; }
+            iterator end() const { return iterator{source_.end(), start_}; }
+            std::size_t size_hint() const { return source_.size_hint(); }
+
+        private:
+
+            Source source_;
+            std::size_t start_;
+    };
+
+    /*
+     * =====================================================================================
+     *        Class:  zip_range
+     *  Description:  Python's zip(a, b).  Stops at the end of the shorter one.
+     * =====================================================================================
+     */
+
+    template<typename A, typename B>
+    class zip_range : public pipeline<zip_range<A, B>>
+    {
+        using a_iterator = decltype(std::declval<const A&>().begin());
+        using b_iterator = decltype(std::declval<const B&>().begin());
+
+        public:
+
+            using element_reference = std::pair<decltype(*std::declval<a_iterator>()), decltype(*std::declval<b_iterator>())>;
+
+            class iterator
+            {
+                public:
+
+                    using iterator_category = std::forward_iterator_tag;
+                    using value_type = element_reference;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = void;
+                    using reference = zip_range::element_reference;
+
+                    iterator() = default;
+                    iterator(a_iterator a, b_iterator b) : a_{a}, b_{b} { }
+
+                    reference operator*() const { return reference{*a_, *b_}; }
+
+                    iterator& operator++() { ++a_; ++b_; return *this; }
+                    iterator operator++(int) { auto result{*this}; ++*this; return result; }
+
+                    // either side running out is the end.
+
+                    bool operator==(const iterator& rhs) const { return a_ == rhs.a_ || b_ == rhs.b_; }
+                    bool operator!=(const iterator& rhs) const { return ! (*this == rhs); }
+
+                private:
+
+                    a_iterator a_{};
+                    b_iterator b_{};
+            };
+
+            zip_range(A a, B b) : a_{std::move(a)}, b_{std::move(b)} { }
+
+            iterator begin() const { return iterator{a_.begin(), b_.begin()}; }
+            iterator end() const { return iterator{a_.end(), b_.end()}; }
+            std::size_t size_hint() const { return std::min(a_.size_hint(), b_.size_hint()); }
+
+        private:
+
+            A a_;
+            B b_;
+    };
+
+    /* ====================  STARTING A PIPELINE  ======================================= */
+
+    template<typename T>
+    struct is_pipeline : std::is_base_of<pipeline<T>, T> { };
+
+    // anything with begin() and end() (a py_vector, a view, a std::vector...) or a
+    // pipeline which is already under way.
+
+    template<typename Iterable>
+    auto all(Iterable& iterable)
+    {
+        if constexpr(is_pipeline<std::remove_const_t<Iterable>>::value)
+        {
+            return iterable;
+        }
+        else
+        {
+            return iterator_range<decltype(std::begin(iterable))>{std::begin(iterable), std::end(iterable)};
+        }
+    }
+
+    template<typename Iterator>
+    auto range(Iterator first, Iterator last)
+    {
+        return iterator_range<Iterator>{first, last};
+    }
+
+    template<typename T, typename Iterator>
+    auto of_type(Iterator first, Iterator last, std::optional<std::size_t> count = {})
+    {
+        return of_type_range<T, Iterator>{first, last, count};
+    }
+
+    template<typename T, typename Iterable>
+    auto of_type(Iterable& iterable)
+    {
+        return of_type<T>(std::begin(iterable), std::end(iterable));
+    }
+
+    // same argument order as Python.  Pipelines can be passed by value, lists have
+    // to be lvalues since we only look at them.
+
+    template<typename Pred, typename Iterable>
+    auto filter(Pred pred, Iterable&& iterable)
+    {
+        static_assert(is_pipeline<std::decay_t<Iterable>>::value || std::is_lvalue_reference_v<Iterable>,
+                "filter needs a pipeline or a list which will outlive it.");
+        return all(iterable).filter(std::move(pred));
+    }
+
+    template<typename F, typename Iterable>
+    auto map(F func, Iterable&& iterable)
+    {
+        static_assert(is_pipeline<std::decay_t<Iterable>>::value || std::is_lvalue_reference_v<Iterable>,
+                "map needs a pipeline or a list which will outlive it.");
+        return all(iterable).map(std::move(func));
+    }
+
+    template<typename Iterable>
+    auto enumerate(Iterable&& iterable, std::size_t start = 0)
+    {
+        static_assert(is_pipeline<std::decay_t<Iterable>>::value || std::is_lvalue_reference_v<Iterable>,
+                "enumerate needs a pipeline or a list which will outlive it.");
+        return all(iterable).enumerate(start);
+    }
+
+    template<typename A, typename B>
+    auto zip(A&& a, B&& b)
+    {
+        static_assert(is_pipeline<std::decay_t<A>>::value || std::is_lvalue_reference_v<A>,
+                "zip needs pipelines or lists which will outlive it.");
+        static_assert(is_pipeline<std::decay_t<B>>::value || std::is_lvalue_reference_v<B>,
+                "zip needs pipelines or lists which will outlive it.");
+        return all(a).zip(all(b));
+    }
+}		/* -----  end of namespace cpp_like_py  ----- */
+
+#endif   /* ----- #ifndef _PY_PIPELINE_INC_  ----- */
@@ -0,0 +1,328 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  py_set.h
+ *
+ *    Description:  python-like set for C++17 built on an open addressing hash table.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 09:48:27 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  David P. Riedel (), driedel@cox.net
+ *   Organization:
+ *
+ * =====================================================================================
+ */
+
+
+#ifndef  _PY_SET_INC_
+#define  _PY_SET_INC_
+
+#include "py_hash_table.h"
+#include "py_vector.h"
+
+/*
+ * =====================================================================================
+ *        Class:  py_set
+ *  Description:  provides a Python-like set class for C++
+ * =====================================================================================
+ */
+
+// Elements are std::variants, stored with their hash.  contains(), add() and friends
+// take either a variant from a compatible type signature or a plain value such as
+// an int or a std::string_view, which is looked up without making a variant.
+//
+// Iteration is in the order elements were added.
+
+template<typename ...Ts>
+class py_set
+{
+    public:
+
+        using value_type = std::variant<Ts...>;
+
+        struct entry
+        {
+            std::size_t hash;
+            value_type value;
+        };
+
+        using table_t = cpp_like_py::flat_table<entry>;
+
+        class const_iterator
+        {
+            public:
+
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = py_set::value_type;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const value_type*;
+                using reference = const value_type&;
+
+                const_iterator() = default;
+                explicit const_iterator(typename table_t::const_iterator it) : it_{it} { }
+
+                reference operator*() const { return it_->value; }
+                pointer operator->() const { return &it_->value; }
+
+                const_iterator& operator++() { ++it_; return *this; }
+                const_iterator operator++(int) { auto result{*this}; ++it_; return result; }
+
+                bool operator==(const const_iterator& rhs) const { return it_ == rhs.it_; }
+                bool operator!=(const const_iterator& rhs) const { return it_ != rhs.it_; }
+
+            private:
+
+                typename table_t::const_iterator it_;
+        };
+
+        /* ====================  LIFECYCLE     ======================================= */
+        py_set () = default;                                                 /* constructor */
+        ~py_set () = default;
+
+        py_set (std::initializer_list<value_type> values)
+        {
+            table_.reserve(values.size());
+            for (const auto& value : values)
+            {
+                add(value);
+            }
+        }
+
+        py_set(const py_set& rhs) = default;
+        py_set(py_set&& rhs) noexcept = default;
+
+        template<typename ... Us>
+        py_set(const py_set<Us...>& rhs)
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>,
+                    "rhs py_set type signature must be proper subset to copy construct.");
+            update(rhs);
+        }
+
+        // Python's set(some_list).
+
+        template<typename S, typename ... Us>
+        explicit py_set(const basic_py_vector<S, Us...>& rhs)
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>,
+                    "rhs py_vector type signature must be proper subset to copy construct.");
+            update(rhs);
+        }
+
+        /* ====================  ACCESSORS     ======================================= */
+
+        auto size() const { return table_.size(); }
+        auto empty() const { return table_.empty(); }
+        auto begin() const { return const_iterator{table_.begin()}; }
+        auto end() const { return const_iterator{table_.end()}; }
+
+        template<typename Y>
+        bool contains(const Y& item) const
+        {
+            return find(item) != table_t::npos;
+        }
+
+        template<typename Y>
+        std::size_t count(const Y& item) const
+        {
+            return contains(item) ? 1 : 0;
+        }
+
+        // same as Python's list(s).
+
+        [[nodiscard]] py_vector<Ts...> to_py_vector() const
+        {
+            py_vector<Ts...> result;
+            result.reserve(table_.size());
+            for (const auto& e : table_)
+            {
+                std::visit([&result](const auto& x) { result.append(x); }, e.value);
+            }
+            return result;
+        }
+
+        void print_set(std::ostream& out, const cpp_like_py::format_options& options = {}) const
+        {
+            auto& buffer = cpp_like_py::scratch_buffer();
+            format_to(buffer, options);
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        }
+
+        [[nodiscard]] std::string to_string(const cpp_like_py::format_options& options = {}) const
+        {
+            cpp_like_py::format_buffer buffer;
+            format_to(buffer, options);
+            return buffer.release();
+        }
+
+        // Python's format: {1, 2, 3} and set() when empty.
+
+        void format_to(cpp_like_py::format_buffer& buffer, const cpp_like_py::format_options& options = {}) const
+        {
+            if (table_.empty())
+            {
+                buffer.append("set()\n");
+                return;
+            }
+
+            const char* separator = "{";
+            for (const auto& e : table_)
+            {
+                buffer.append(separator);
+                std::visit([&](const auto& x) { cpp_like_py::format_value(buffer, x, options); }, e.value);
+                separator = ", ";
+            }
+            buffer.append("}\n");
+        }
+
+        /* ====================  MUTATORS      ======================================= */
+
+        void reserve(std::size_t new_capacity) { table_.reserve(new_capacity); }
+        void clear() { table_.clear(); }
+
+        // returns false if the set already had it.
+
+        template<typename Y>
+        bool add(Y&& item)
+        {
+            const auto hash = cpp_like_py::key_hash(item);
+            if (table_.find(hash, [&item](const entry& e) { return cpp_like_py::key_matches(e.value, item); }) != table_t::npos)
+            {
+                return false;
+            }
+            table_.insert_new(hash, make_value(std::forward<Y>(item)));
+            return true;
+        }
+
+        // Python's set.update(): add everything in a set or list.
+
+        template<typename Container>
+        py_set& update(const Container& rhs)
+        {
+            table_.reserve(table_.size() + rhs.size());
+            for (const auto& value : rhs)
+            {
+                add(value);
+            }
+            return *this;
+        }
+
+        // Python's set.discard().  Returns true if it was there.
+
+        template<typename Y>
+        bool discard(const Y& item)
+        {
+            const auto pos = find(item);
+            if (pos == table_t::npos)
+            {
+                return false;
+            }
+            table_.erase_at(pos);
+            return true;
+        }
+
+        // Python's set.remove() which raises KeyError if it isn't there.
+
+        template<typename Y>
+        void remove(const Y& item)
+        {
+            if (! discard(item))
+            {
+                throw std::out_of_range{"py_set: item not found."};
+            }
+        }
+
+        /* ====================  OPERATORS     ======================================= */
+
+        py_set& operator=(const py_set& rhs) = default;
+        py_set& operator=(py_set&& rhs) noexcept = default;
+
+        // Python's s |= t
+
+        template<typename ... Us>
+        py_set& operator|=(const py_set<Us...>& rhs)
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>,
+                    "rhs py_set type signature must be proper subset to update.");
+            return update(rhs);
+        }
+
+        // equal sets have the same elements, in any order.
+
+        template<typename ... Us>
+        bool operator==(const py_set<Us...>& rhs) const
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>,
+                    "rhs py_set type signature must be proper subset to test equivalence.");
+
+            if (size() != rhs.size())
+            {
+                return false;
+            }
+            for (const auto& value : rhs)
+            {
+                if (! contains(value))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template<typename ... Us>
+        bool operator!=(const py_set<Us...>& rhs) const
+        {
+            return ! (*this == rhs);
+        }
+
+    protected:
+        /* ====================  METHODS       ======================================= */
+
+        /* ====================  DATA MEMBERS  ======================================= */
+
+    private:
+        /* ====================  METHODS       ======================================= */
+
+        // a plain value has to be one of our types, or string like if we hold strings.
+        // A variant from another type signature can hold things we never do and
+        // that's fine, they just aren't found.
+
+        template<typename Y>
+        std::size_t find(const Y& item) const
+        {
+            if constexpr(! cpp_like_py::is_variant_v<Y>)
+            {
+                static_assert(cpp_like_py::is_key_lookup_type_v<Y, Ts...>, "Type Y must be in type signature of py_set.");
+            }
+            return table_.find(cpp_like_py::key_hash(item), [&item](const entry& e) { return cpp_like_py::key_matches(e.value, item); });
+        }
+
+        template<typename Y>
+        static value_type make_value(Y&& item)
+        {
+            using V = std::decay_t<Y>;
+            if constexpr(cpp_like_py::is_variant_v<V>)
+            {
+                return std::visit([](auto&& x) { return make_value(std::forward<decltype(x)>(x)); }, std::forward<Y>(item));
+            }
+            else if constexpr(mp11::mp_contains<mp11::mp_list<Ts...>, V>::value)
+            {
+                return value_type(std::in_place_index<mp11::mp_find<mp11::mp_list<Ts...>, V>::value>, std::forward<Y>(item));
+            }
+            else
+            {
+                static_assert(cpp_like_py::is_key_lookup_type_v<V, Ts...>, "Type Y must be in type signature of py_set.");
+                return value_type(std::in_place_index<mp11::mp_find<mp11::mp_list<Ts...>, std::string>::value>, std::string_view{item});
+            }
+        }
+
+        /* ====================  DATA MEMBERS  ======================================= */
+
+        table_t table_;
+
+}; /* ----------  end of template class py_set  ---------- */
+
+#endif   /* ----- #ifndef _PY_SET_INC_  ----- */
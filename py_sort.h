@@ -0,0 +1,252 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  py_sort.h
+ *
+ *    Description:  sorting kernels for contiguous arrays of unwrapped values.  Used by
+ *                  py_vector's sort methods once its elements are grouped by type.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 10:52:06 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  David P. Riedel (), driedel@cox.net
+ *   Organization:
+ *
+ * =====================================================================================
+ */
+
+
+#ifndef  _PY_SORT_INC_
+#define  _PY_SORT_INC_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "parallel_chunks.h"
+
+namespace cpp_like_py
+{
+    namespace kernels
+    {
+        // integers and floats of up to 8 bytes are radix sorted.  Each value is turned
+        // into an unsigned key which sorts the same way, sorted, and turned back.
+
+        template<typename T>
+        inline constexpr bool is_radix_sortable_v = (std::is_integral_v<T> || std::is_same_v<T, float>
+                || std::is_same_v<T, double>) && sizeof(T) <= sizeof(std::uint64_t);
+
+        template<std::size_t N> struct unsigned_of_size;
+        template<> struct unsigned_of_size<1> { using type = std::uint8_t; };
+        template<> struct unsigned_of_size<2> { using type = std::uint16_t; };
+        template<> struct unsigned_of_size<4> { using type = std::uint32_t; };
+        template<> struct unsigned_of_size<8> { using type = std::uint64_t; };
+
+        template<typename T>
+        using radix_key_t = typename unsigned_of_size<sizeof(T)>::type;
+
+        // signed integers: flip the sign bit.  Floating point: flip every bit of a
+        // negative number, just the sign bit of a positive one.  That gives IEEE total
+        // order: -NaN, -inf, ..., -0, +0, ..., +inf, +NaN.
+
+        template<typename T>
+        radix_key_t<T> to_radix_key(T value)
+        {
+            using U = radix_key_t<T>;
+            constexpr U sign_bit = U{1} << (sizeof(U) * 8 - 1);
+
+            if constexpr(std::is_floating_point_v<T>)
+            {
+                U bits;
+                std::memcpy(&bits, &value, sizeof(T));
+                return (bits & sign_bit) ? U(~bits) : U(bits | sign_bit);
+            }
+            else if constexpr(std::is_signed_v<T>)
+            {
+                return U(U(value) ^ sign_bit);
+            }
+            else
+            {
+                return U(value);
+            }
+        }
+
+        template<typename T>
+        T from_radix_key(radix_key_t<T> key)
+        {
+            using U = radix_key_t<T>;
+            constexpr U sign_bit = U{1} << (sizeof(U) * 8 - 1);
+
+            if constexpr(std::is_floating_point_v<T>)
+            {
+                const U bits = (key & sign_bit) ? U(key ^ sign_bit) : U(~key);
+                T value;
+                std::memcpy(&value, &bits, sizeof(T));
+                return value;
+            }
+            else if constexpr(std::is_signed_v<T>)
+            {
+                return T(U(key ^ sign_bit));
+            }
+            else
+            {
+                return T(key);
+            }
+        }
+
+        // the order sort() puts values of type T in.  Same as operator< except floating
+        // point NaNs have a place instead of making the sort undefined.
+
+        template<typename T>
+        auto value_less()
+        {
+            if constexpr(is_radix_sortable_v<T>)
+            {
+                return [](const T& a, const T& b) { return to_radix_key(a) < to_radix_key(b); };
+            }
+            else
+            {
+                return std::less<T>{};
+            }
+        }
+
+        // the same, backwards for reverse=True.  Equal values still compare equal so a
+        // stable sort keeps them in their original order, as Python does.
+
+        template<typename T>
+        auto value_order(bool reverse)
+        {
+            return [reverse, less = value_less<T>()](const T& a, const T& b) { return reverse ? less(b, a) : less(a, b); };
+        }
+
+        // least significant byte first, 1 pass per byte.  All the byte counts are taken
+        // in one pass up front so we can skip bytes which are the same in every key.
+
+        template<typename U>
+        void radix_sort_keys(std::vector<U>& keys)
+        {
+            constexpr std::size_t bytes = sizeof(U);
+            std::array<std::array<std::size_t, 256>, bytes> counts{};
+
+            for (const U key : keys)
+            {
+                for (std::size_t b = 0; b < bytes; ++b)
+                {
+                    ++counts[b][(key >> (b * 8)) & 0xff];
+                }
+            }
+
+            std::vector<U> scratch(keys.size());
+            for (std::size_t b = 0; b < bytes; ++b)
+            {
+                auto& count = counts[b];
+                if (std::any_of(count.begin(), count.end(), [n = keys.size()](std::size_t c) { return c == n; }))
+                {
+                    continue;
+                }
+
+                std::size_t offset{0};
+                for (auto& c : count)
+                {
+                    const auto this_many = c;
+                    c = offset;
+                    offset += this_many;
+                }
+                for (const U key : keys)
+                {
+                    scratch[count[(key >> (b * 8)) & 0xff]++] = key;
+                }
+                keys.swap(scratch);
+            }
+        }
+
+        // sorts [first, last).  Small arrays aren't worth the radix sort's set up.
+
+        template<typename T>
+        void sort_range(T* first, T* last, bool stable, bool reverse)
+        {
+            const auto count = static_cast<std::size_t>(last - first);
+
+            if constexpr(is_radix_sortable_v<T>)
+            {
+                // equal keys are identical values so stability takes care of itself, and
+                // so does reversing.
+
+                if (count < 256)
+                {
+                    std::sort(first, last, value_order<T>(reverse));
+                    return;
+                }
+
+                std::vector<radix_key_t<T>> keys(count);
+                std::transform(first, last, keys.begin(), [](T x) { return to_radix_key(x); });
+                radix_sort_keys(keys);
+                if (reverse)
+                {
+                    std::reverse(keys.begin(), keys.end());
+                }
+                std::transform(keys.begin(), keys.end(), first, [](radix_key_t<T> key) { return from_radix_key<T>(key); });
+            }
+            else
+            {
+                if (stable)
+                {
+                    std::stable_sort(first, last, value_order<T>(reverse));
+                }
+                else
+                {
+                    std::sort(first, last, value_order<T>(reverse));
+                }
+            }
+        }
+
+        template<typename T>
+        void sort_values(const execution::sequenced_policy&, std::vector<T>& values, bool stable, bool reverse)
+        {
+            sort_range(values.data(), values.data() + values.size(), stable, reverse);
+        }
+
+        // each chunk is sorted on its own thread, then neighbouring runs are merged
+        // pairwise, also in parallel, until there is 1 run left.  Merging is stable so a
+        // stable sort stays stable.
+
+        template<typename T>
+        void sort_values(const execution::parallel_policy& policy, std::vector<T>& values, bool stable, bool reverse)
+        {
+            const std::size_t count = values.size();
+            const std::size_t chunk_size = std::max<std::size_t>(policy.chunk_size, 1);
+            if (chunk_count(policy, count) <= 1)
+            {
+                sort_range(values.data(), values.data() + count, stable, reverse);
+                return;
+            }
+
+            T* data = values.data();
+            for_each_chunk(policy, count, [data, stable, reverse](std::size_t, std::size_t first, std::size_t last)
+            {
+                sort_range(data + first, data + last, stable, reverse);
+            });
+
+            const execution::parallel_policy one_merge_at_a_time{policy.threads, 1};
+            for (std::size_t width = chunk_size; width < count; width *= 2)
+            {
+                const std::size_t pairs = (count + 2 * width - 1) / (2 * width);
+                for_each_chunk(one_merge_at_a_time, pairs, [data, width, count, reverse](std::size_t pair, std::size_t, std::size_t)
+                {
+                    const std::size_t first = pair * 2 * width;
+                    const std::size_t middle = std::min(first + width, count);
+                    const std::size_t last = std::min(first + 2 * width, count);
+                    std::inplace_merge(data + first, data + middle, data + last, value_order<T>(reverse));
+                });
+            }
+        }
+    }		/* -----  end of namespace kernels  ----- */
+}		/* -----  end of namespace cpp_like_py  ----- */
+
+#endif   /* ----- #ifndef _PY_SORT_INC_  ----- */
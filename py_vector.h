@@ -22,18 +22,33 @@
 
 #include <algorithm>
 #include <any>
+#include <array>
+#include <cstdint>
 #include <functional>
 #include <initializer_list>
 #include <iostream>
 #include <iterator>
+#include <memory>
+#include <numeric>
+#include <optional>
 #include <sstream>
+#include <stdexcept>
+#include <tuple>
 #include <type_traits>
 #include <typeinfo>
+#include <utility>
 #include <variant>
 #include <vector>
 
 #include <boost/mp11.hpp>
 
+#include "numeric_kernels.h"
+#include "parallel_chunks.h"
+#include "py_format.h"
+#include "py_pipeline.h"
+#include "py_sort.h"
+#include "py_vector_stats.h"
+
 namespace mp11 = boost::mp11;
 
 // I need to be able to compare 2 variants of different types.
@@ -45,30 +60,65 @@ namespace mp11 = boost::mp11;
 
 namespace cpp_like_py
 {
+    // a compile time table which translates the index of each alternative in type list 'From'
+    // to the index of the first alternative in type list 'To' with the same type.
+    // If 'To' can not hold that type, the entry is the size of 'To'.
+    // This lets us copy and compare between variants of different type signatures by index
+    // instead of building temporary variants or comparing every combination of types.
+
+    template<typename To, typename From> struct alternative_translation;
+
+    template<typename ...Ts, typename ...Us>
+    struct alternative_translation<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>
+    {
+        static constexpr std::array<std::size_t, sizeof...(Us)> value{ {mp11::mp_find<mp11::mp_list<Ts...>, Us>::value ...} };
+    };
+
     template<typename ...Ts, typename ...Us>
     bool operator==(const std::variant<Ts ...>& lhs, const std::variant<Us ...>& rhs)
     {
+        if (lhs.valueless_by_exception() || rhs.valueless_by_exception())
+        {
+            return false;
+        }
+
+        // different types are never equal so look at the indexes before any values.
+        // translating both sides into lhs terms takes care of duplicate types in lhs.
+
+        using to_lhs = alternative_translation<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>;
+        using lhs_canonical = alternative_translation<mp11::mp_list<Ts...>, mp11::mp_list<Ts...>>;
+
+        if (to_lhs::value[rhs.index()] != lhs_canonical::value[lhs.index()])
+        {
+            return false;
+        }
+
         bool result{false};
 
         mp11::mp_with_index<sizeof...(Ts)>(lhs.index(), [&](auto I)
         {
             using X = std::variant_alternative_t<I, std::variant<Ts ...>>;
-            X x = std::get<I>(lhs);
+            const X& x = std::get<I>(lhs);
 
-            mp11::mp_with_index<sizeof...(Us)>(rhs.index(), [&](auto J)
-            {
-                using Y = std::variant_alternative_t<J, std::variant<Us ...>>;
-                Y y = std::get<J>(rhs);
+            // usually there is exactly one alternative of type X on the other side.
 
-                if constexpr(! std::is_same_v<X, Y>)
-                {
-                    result = false;
-                }
-                else
+            using rhs_count = mp11::mp_count<mp11::mp_list<Us...>, X>;
+
+            if constexpr(rhs_count::value == 1)
+            {
+                result = (x == std::get<mp11::mp_find<mp11::mp_list<Us...>, X>::value>(rhs));
+            }
+            else if constexpr(rhs_count::value > 1)
+            {
+                mp11::mp_with_index<sizeof...(Us)>(rhs.index(), [&](auto J)
                 {
-                    result = (x == y);
-                }
-            });
+                    using Y = std::variant_alternative_t<J, std::variant<Us ...>>;
+                    if constexpr(std::is_same_v<X, Y>)
+                    {
+                        result = (x == std::get<J>(rhs));
+                    }
+                });
+            }
         });
         return result;
     }
@@ -87,7 +137,7 @@ namespace cpp_like_py
 
 /*
  * =====================================================================================
- *        Class:  py_vector
+ *        Class:  basic_py_vector
  *  Description:  provides a Python-like list class for C++
  * =====================================================================================
  */
@@ -101,215 +151,450 @@ namespace cpp_like_py
 template<typename ...Ts>
         using new_types_set_ = typename mp11::mp_unique<mp11::mp_list<Ts...>>;
 
-template<typename ...Ts>
-class py_vector
+// the subset test from above packaged up so the other containers in this project
+// can use it.  true if every type in type list 'Other' can be held by type list 'Ours'.
+
+template<typename Ours, typename Other>
+        inline constexpr bool types_are_subset_v = std::is_same_v<
+            mp11::mp_size<mp11::mp_set_intersection<mp11::mp_unique<Ours>, mp11::mp_unique<Other>>>,
+            mp11::mp_size<mp11::mp_unique<Other>>>;
+
+// smallest unsigned type which can hold the index of any alternative in a type signature
+// of 'N' types.  Used where we keep our own type tags instead of a std::variant.
+
+template<std::size_t N>
+        using type_tag_t = std::conditional_t<(N <= 256), std::uint8_t, std::uint16_t>;
+
+namespace cpp_like_py
 {
-    public:
+    // an element matches an item only if it holds the item's type and the values are equal.
 
-        using value_type = std::variant<Ts...>;
-        using pylist_t = std::vector<value_type>;
+    template<typename ...Ts, typename Y>
+    bool holds_equal(const std::variant<Ts...>& elem, const Y& item)
+    {
+        bool result{false};
+        mp11::mp_with_index<sizeof...(Ts)>(elem.index(), [&](auto I)
+        {
+            using X = std::variant_alternative_t<I, std::variant<Ts ...>>;
+            if constexpr(std::is_same_v<X, Y>)
+            {
+                const X& x = std::get<I>(elem);
+                result = (x == item);
+            }
+        });
+        return result;
+    }
+}		/* -----  end of namespace cpp_like_py  ----- */
 
-        /* ====================  LIFECYCLE     ======================================= */
-        py_vector () = default;                                              /* constructor */
-        ~py_vector () = default;
+/*
+ * =====================================================================================
+ *        Class:  py_slice
+ *  Description:  Python's [start:stop:step].  Leave out start or stop with {}.
+ * =====================================================================================
+ */
 
-        template<typename ...Args>
-        explicit py_vector (Args ...args) : the_list_{{args} ...} { }              /* constructor */
-        py_vector (std::initializer_list<value_type> values) : the_list_{values} {}
+//  x[2:5]      py_slice{2, 5}
+//  x[-3:]      py_slice{-3, {}}
+//  x[::-1]     py_slice{{}, {}, -1}
+
+struct py_slice
+{
+    std::optional<std::ptrdiff_t> start;
+    std::optional<std::ptrdiff_t> stop;
+    std::ptrdiff_t step = 1;
 
-        py_vector(const py_vector& rhs) : the_list_{rhs.the_list_} { }
-        py_vector(py_vector&& rhs) noexcept : the_list_{std::move(rhs.the_list_)} { }
+    // what Python's slice.indices() works out: where to start, how far to step
+    // and how many elements that gives for a list of the given length.
 
-        // now, let's try some metaprogramming....
-        // NOTE: per "C++ Templates the Complete Guide, 2nd ed." (pp.102,103), this is necessary to force use
-        // of customized copy ctor.
-        
-        py_vector(py_vector const volatile& rhs) = delete;
+    struct resolved
+    {
+        std::ptrdiff_t start;
+        std::ptrdiff_t step;
+        std::size_t count;
+    };
 
-        template<typename ... Us>
-        explicit py_vector(const py_vector<Us...>& rhs)
+    resolved resolve(std::size_t length) const
+    {
+        if (step == 0)
         {
-            // now, make sure the we have all the types the class we are copying from does.
-            //
-            if constexpr(std::is_same_v<mp11::mp_size<mp11::mp_set_intersection<new_types_set_<Ts...>,
-                    new_types_set_<Us...>>>, mp11::mp_size<new_types_set_<Us...>>>)
-            {
-                // we can not simply copy the variant elements from the rhs vector, we need to use
-                // our own type of variant elements which, thanks to check above, we know can handle
-                // all the types possible in rhs.
-               
-                auto copy_value([this](const auto& e)
-                {
-                    using X = std::remove_cv_t<std::remove_reference_t<decltype(e)>>;
-                    value_type new_elem{std::in_place_type<X>, e};
-                    this->the_list_.push_back(new_elem);
-                 }); 
+            throw std::invalid_argument{"slice step cannot be zero"};
+        }
 
-                for (const auto& r_element : rhs.the_list_)
-                {
-                    std::visit(copy_value, r_element);
-                 
-                }
-            }
-            else
+        const auto len = static_cast<std::ptrdiff_t>(length);
+
+        // negative numbers count back from the end.  Anything out of range is pulled
+        // back to the nearest end, which is different for the 2 directions.
+
+        auto adjust([len](std::ptrdiff_t index, std::ptrdiff_t lowest, std::ptrdiff_t highest)
+        {
+            if (index < 0)
             {
-                // just use this to get a more understandable compile error if our type signatures at not compatible.
-               
-                static_assert(std::is_same_v<std::true_type, std::false_type>,
-                        "rhs py_vector type signature must be proper subset to copy construct.");
+                index += len;
             }
+            return std::clamp(index, lowest, highest);
+        });
 
+        resolved result{0, step, 0};
+
+        if (step > 0)
+        {
+            const std::ptrdiff_t first = start ? adjust(*start, 0, len) : 0;
+            const std::ptrdiff_t last = stop ? adjust(*stop, 0, len) : len;
+            result.start = first;
+            result.count = last > first ? static_cast<std::size_t>((last - first - 1) / step + 1) : 0;
         }
+        else
+        {
+            const std::ptrdiff_t first = start ? adjust(*start, -1, len - 1) : len - 1;
+            const std::ptrdiff_t last = stop ? adjust(*stop, -1, len - 1) : -1;
+            result.start = first;
+            result.count = first > last ? static_cast<std::size_t>((first - last - 1) / (-step) + 1) : 0;
+        }
+        return result;
+    }
+};
+
+/*
+ * =====================================================================================
+ *        Class:  py_vector_view
+ *  Description:  a strided window onto the elements of a py_vector.  Copies nothing.
+ * =====================================================================================
+ */
+
+// 'Iterator' is the random access iterator of the list we look at.  A view made from a
+// const list can't change its elements.  Like any iterator, a view is no good after
+// the list it looks at is changed in a way which invalidates its iterators.
+
+template<typename Iterator>
+class py_vector_view
+{
+    public:
+
+        using value_type = typename std::iterator_traits<Iterator>::value_type;
+        using reference = typename std::iterator_traits<Iterator>::reference;
+
+        class iterator
+        {
+            public:
+
+                using iterator_category = std::random_access_iterator_tag;
+                using value_type = py_vector_view::value_type;
+                using difference_type = std::ptrdiff_t;
+                using pointer = typename std::iterator_traits<Iterator>::pointer;
+                using reference = py_vector_view::reference;
+
+                iterator() = default;
+                iterator(Iterator base, std::ptrdiff_t step, std::ptrdiff_t pos) : base_{base}, step_{step}, pos_{pos} { }
+
+                reference operator*() const { return base_[pos_ * step_]; }
+                pointer operator->() const { return &base_[pos_ * step_]; }
+                reference operator[](difference_type n) const { return base_[(pos_ + n) * step_]; }
+
+                iterator& operator++() { ++pos_; return *this; }
+                iterator operator++(int) { auto result{*this}; ++pos_; return result; }
+                iterator& operator--() { --pos_; return *this; }
+                iterator operator--(int) { auto result{*this}; --pos_; return result; }
+                iterator& operator+=(difference_type n) { pos_ += n; return *this; }
+                iterator& operator-=(difference_type n) { pos_ -= n; return *this; }
+                iterator operator+(difference_type n) const { return iterator{base_, step_, pos_ + n}; }
+                iterator operator-(difference_type n) const { return iterator{base_, step_, pos_ - n}; }
+                difference_type operator-(const iterator& rhs) const { return pos_ - rhs.pos_; }
+
+                bool operator==(const iterator& rhs) const { return pos_ == rhs.pos_; }
+                bool operator!=(const iterator& rhs) const { return pos_ != rhs.pos_; }
+                bool operator<(const iterator& rhs) const { return pos_ < rhs.pos_; }
+                bool operator>(const iterator& rhs) const { return pos_ > rhs.pos_; }
+                bool operator<=(const iterator& rhs) const { return pos_ <= rhs.pos_; }
+                bool operator>=(const iterator& rhs) const { return pos_ >= rhs.pos_; }
+
+            private:
+
+                Iterator base_{};
+                std::ptrdiff_t step_ = 1;
+                std::ptrdiff_t pos_ = 0;
+        };
+
+        using const_iterator = iterator;
 
-        template<typename ...Us> friend class py_vector;
+        /* ====================  LIFECYCLE     ======================================= */
+        py_vector_view () = default;                                         /* constructor */
+
+        // 'first' is the first element we see, then every 'step'th one after that.
+
+        py_vector_view (Iterator first, std::ptrdiff_t step, std::size_t count)
+            : first_{first}, step_{step}, count_{count} { }
 
         /* ====================  ACCESSORS     ======================================= */
 
-        auto size() const { return the_list_.size(); }
-        auto begin() const { return the_list_.begin(); }
-        auto cbegin() const { return the_list_.cbegin(); }
-        auto end() const { return the_list_.end(); }
-        auto cend() const { return the_list_.cend(); }
-        auto empty() const { return  the_list_.empty(); }
+        auto size() const { return count_; }
+        auto empty() const { return count_ == 0; }
+        auto begin() const { return iterator{first_, step_, 0}; }
+        auto cbegin() const { return begin(); }
+        auto end() const { return iterator{first_, step_, static_cast<std::ptrdiff_t>(count_)}; }
+        auto cend() const { return end(); }
 
-        void print_list(std::ostream& out) const
+        reference operator[](std::size_t index) const
         {
-            auto print_item([&out](const auto& e) { out << ", " << e ; });
-            auto print_first_item([&out](const auto& e) { out << e ; });
-            
-            out << '[';
+            return first_[static_cast<std::ptrdiff_t>(index) * step_];
+        }
 
-            if (! the_list_.empty())
+        // slicing a view gives another view of the same list.
+
+        py_vector_view view(const py_slice& slice) const
+        {
+            const auto where = slice.resolve(count_);
+            if (where.count == 0)
             {
-                auto it = the_list_.cbegin();
-                std::visit(print_first_item, *it);
-                for(++it; it != the_list_.cend(); ++it)
-                {
-                    std::visit(print_item, *it);
-                }
+                return py_vector_view{first_, step_, 0};
             }
-            out << "]\n";
+            return py_vector_view{first_ + where.start * step_, where.step * step_, where.count};
         }
 
-        [[nodiscard]] std::string to_string() const
+        void print_list(std::ostream& out, const cpp_like_py::format_options& options = {}) const
         {
-            std::ostringstream out;
-            print_list(out);
-            return out.str();
+            cpp_like_py::print_elements(out, begin(), end(), options);
         }
 
-        // half open range
-        py_vector slice(int lower_bound, int upper_bound) const
+        [[nodiscard]] std::string to_string(const cpp_like_py::format_options& options = {}) const
         {
-            auto end = upper_bound > the_list_.size() ? the_list_.size() : upper_bound;
-            auto start = lower_bound < 0 ? 0 : lower_bound;
-
-            py_vector result;
-
-            std::copy(&the_list_[start], &the_list_[end], std::back_inserter(result.the_list_));
-            return result;
+            cpp_like_py::format_buffer buffer;
+            cpp_like_py::format_elements(buffer, begin(), end(), options);
+            return buffer.release();
         }
 
         template<typename Y>
         bool contains(const Y& item) const
         {
-            for (const auto& elem : the_list_)
-            {
-                bool result{false};
-                mp11::mp_with_index<sizeof...(Ts)>(elem.index(), [&](auto I)
-                {
-                    using X = std::variant_alternative_t<I, std::variant<Ts ...>>;
-                    if constexpr(std::is_same_v<X, Y>)
-                    {
-                        const X& x = std::get<I>(elem);
-                        result = (x == item);
-                    }
-                });
-                if (result)
-                {
-                    return true;
-                }
-            }
-            return false;
+            return std::any_of(begin(), end(), [&item](const value_type& elem) { return cpp_like_py::holds_equal(elem, item); });
         }
 
-        // this method will apply the supplied function to all list elements
-        // of the specified type.
-        
-        template<typename T, class F>
-        void visit_all(F& func)
+        template<typename Y>
+        std::size_t count(const Y& item) const
         {
-            using good_type = mp11::mp_contains<new_types_set_<Ts...>, T>;
-            static_assert(std::is_same_v<good_type, mp11::mp_true>, "Type T must be in type signature of py_vector.");
+            return std::count_if(begin(), end(), [&item](const value_type& elem) { return cpp_like_py::holds_equal(elem, item); });
+        }
 
-            auto apply_func([func](auto& elem)
+        // applies func to the elements of type T we can see.  If we are a view of a
+        // non-const list, func can change them.
+
+        template<typename T, class F>
+        void visit_all(F& func) const
+        {
+            for (auto&& elem : *this)
             {
-                // we the index here rather than type since we can have multiple
-                // instances of a type in our type signature.
-                
-                mp11::mp_with_index<sizeof...(Ts)>(elem.index(), [&](auto I)
+                mp11::mp_with_index<std::variant_size_v<value_type>>(elem.index(), [&](auto I)
                 {
-                    using X = std::variant_alternative_t<I, std::variant<Ts ...>>;
+                    using X = std::variant_alternative_t<I, value_type>;
                     if constexpr (std::is_same_v<T, X>)
                     {
-                        // we take a reference here because we may
-                        // modify the values in our list.
-                        
-                        X& x = std::get<I>(elem);
-                        func(x);
+                        func(std::get<I>(elem));
                     }
                 });
-            });
-            std::for_each(the_list_.begin(), the_list_.end(), apply_func);
+            }
         }
 
-        /* ====================  MUTATORS      ======================================= */
-        
-        py_vector& append(const py_vector& rhs)
+        // compares with anything which looks like a list of variants: another view
+        // or a py_vector of any compatible type signature.
+
+        template<typename List>
+        bool operator==(const List& rhs) const
         {
-            if (this != & rhs)
-            {
-                std::copy(rhs.the_list_.cbegin(), rhs.the_list_.cend(), std::back_inserter(the_list_));
-            }
-            return *this;
+            return count_ == rhs.size() && std::equal(begin(), end(), rhs.begin(),
+                    [](const auto& a, const auto& b) { return cpp_like_py::operator==(a, b); });
         }
 
-        py_vector& append(std::initializer_list<value_type> new_values)
+        template<typename List>
+        bool operator!=(const List& rhs) const
         {
-            std::copy(new_values.begin(), new_values.end(), std::back_inserter(the_list_));
-            return *this;
+            return ! (*this == rhs);
         }
 
-        template<typename T>
-        py_vector& append(const T& element)
+    private:
+
+        /* ====================  DATA MEMBERS  ======================================= */
+
+        Iterator first_{};
+        std::ptrdiff_t step_ = 1;
+        std::size_t count_ = 0;
+
+}; /* ----------  end of template class py_vector_view  ---------- */
+
+// the elements are kept in a vector-like container supplied by a storage policy.
+// The policy has a member template 'container_t' which gives the container to use for
+// our variant type.  The usual py_vector keeps them in a std::vector.  Other policies
+// (see small_py_vector.h) let us change where the elements live without changing
+// anything else about the list.
+
+struct vector_storage
+{
+    template<typename V>
+        using container_t = std::vector<V>;
+};
+
+namespace cpp_like_py
+{
+    // the allocator of a storage policy's container.  Containers which don't take one
+    // (small_vector) are treated as using std::allocator.
+
+    template<typename Container, typename = void>
+    struct container_allocator
+    {
+        using type = std::allocator<typename Container::value_type>;
+    };
+
+    template<typename Container>
+    struct container_allocator<Container, std::void_t<typename Container::allocator_type>>
+    {
+        using type = typename Container::allocator_type;
+    };
+
+    // a storage policy can ask that its allocator be passed on to the alternatives which
+    // can use it (std::pmr::string for example).  See allocator_py_vector.h.
+
+    template<typename Storage, typename = void>
+    struct storage_propagates_allocator : std::false_type { };
+
+    template<typename Storage>
+    struct storage_propagates_allocator<Storage, std::void_t<decltype(Storage::propagate_allocator)>>
+        : std::bool_constant<Storage::propagate_allocator> { };
+
+    // a storage policy's container can let a slice share its elements instead of
+    // copying them.  See cow_py_vector.h.
+
+    template<typename Container, typename = void>
+    struct container_shares_slices : std::false_type { };
+
+    template<typename Container>
+    struct container_shares_slices<Container, std::void_t<decltype(std::declval<const Container&>().share(0, 0))>>
+        : std::true_type { };
+
+    // a storage policy's container can say that only one thread at a time may use it,
+    // even through const, since reading an element can change what it holds in memory.
+    // Work asked for with par is then done with seq.  See spill_py_vector.h.
+
+    template<typename Container, typename = void>
+    struct container_is_single_threaded : std::false_type { };
+
+    template<typename Container>
+    struct container_is_single_threaded<Container, std::void_t<decltype(Container::single_threaded)>>
+        : std::bool_constant<Container::single_threaded> { };
+
+    template<typename ...Args>
+    inline constexpr bool starts_with_allocator_arg_v = std::is_same_v<
+        mp11::mp_take_c<mp11::mp_list<std::decay_t<Args>..., void>, 1>, mp11::mp_list<std::allocator_arg_t>>;
+}		/* -----  end of namespace cpp_like_py  ----- */
+
+template<typename Storage, typename ...Ts>
+class basic_py_vector;
+
+template<typename ...Ts>
+        using py_vector = basic_py_vector<vector_storage, Ts...>;
+
+namespace cpp_like_py
+{
+    // so the element overloads of append etc. stay out of the way of the list overloads.
+
+    template<typename T>
+    struct is_basic_py_vector : std::false_type { };
+
+    template<typename Storage, typename ...Ts>
+    struct is_basic_py_vector<basic_py_vector<Storage, Ts...>> : std::true_type { };
+
+    template<typename T>
+    inline constexpr bool is_basic_py_vector_v = is_basic_py_vector<std::decay_t<T>>::value;
+
+    template<typename T>
+    struct is_variant : std::false_type { };
+
+    template<typename ...Ts>
+    struct is_variant<std::variant<Ts...>> : std::true_type { };
+
+    template<typename T>
+    inline constexpr bool is_variant_v = is_variant<std::decay_t<T>>::value;
+}		/* -----  end of namespace cpp_like_py  ----- */
+
+template<typename Storage, typename ...Ts>
+class basic_py_vector : public cpp_like_py::list_stats<basic_py_vector<Storage, Ts...>, Ts...>
+{
+    public:
+
+        using storage_t = Storage;
+        using value_type = std::variant<Ts...>;
+        using pylist_t = typename Storage::template container_t<value_type>;
+        using allocator_type = typename cpp_like_py::container_allocator<pylist_t>::type;
+
+        /* ====================  LIFECYCLE     ======================================= */
+        basic_py_vector () = default;                                        /* constructor */
+        ~basic_py_vector () = default;
+
+        template<typename ...Args, typename = std::enable_if_t<! cpp_like_py::starts_with_allocator_arg_v<Args...>>>
+        explicit basic_py_vector (Args ...args) : the_list_{{args} ...}           /* constructor */
         {
-            value_type e(std::in_place_type<T>, element);
-            the_list_.push_back(e);
-            return *this;
+            this->note_filled(the_list_);
+            count_from(0);
         }
 
-        // half open range
-        
-        py_vector& erase(std::size_t from, std::size_t to)
+        basic_py_vector (std::initializer_list<value_type> values) : the_list_{values}
         {
-            the_list_.erase(the_list_.begin() + from, the_list_.begin() + to);
-            return *this;
+            this->note_filled(the_list_);
+            count_from(0);
         }
 
-        /* ====================  OPERATORS     ======================================= */
+        // allocator-extended constructors.  These follow the std::allocator_arg convention
+        // so they can't be confused with the list of elements constructor above.
+
+        basic_py_vector (std::allocator_arg_t, const allocator_type& alloc) : the_list_(alloc) { }
 
-        py_vector& operator=(const py_vector& rhs)
+        basic_py_vector (std::allocator_arg_t, const allocator_type& alloc, std::initializer_list<value_type> values)
+            : the_list_(alloc)
         {
-            if (this != &rhs)
-            {
-                the_list_ = rhs.the_list_;
-            }
-            return *this;
+            append_translated(the_list_, values.begin(), values.end());
+            this->note_filled(the_list_);
+            count_from(0);
+        }
+
+        basic_py_vector (std::allocator_arg_t, const allocator_type& alloc, const basic_py_vector& rhs)
+            : the_list_(alloc)
+        {
+            append_translated(the_list_, rhs.the_list_);
+            this->note_filled(the_list_);
+            count_from(0);
+        }
+
+        template<typename S, typename ... Us>
+        basic_py_vector (std::allocator_arg_t, const allocator_type& alloc, const basic_py_vector<S, Us...>& rhs)
+            : the_list_(alloc)
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>,
+                    "rhs py_vector type signature must be proper subset to copy construct.");
+            append_translated(the_list_, rhs.the_list_);
+            this->note_filled(the_list_);
+            count_from(0);
+        }
+
+        basic_py_vector(const basic_py_vector& rhs)
+            : cpp_like_py::list_stats<basic_py_vector, Ts...>{rhs}, the_list_{rhs.the_list_}, type_counts_{rhs.type_counts_}, counts_stale_{rhs.counts_stale_}
+        {
+            this->note_filled(the_list_);
+        }
+
+        basic_py_vector(basic_py_vector&& rhs) noexcept
+            : the_list_{std::move(rhs.the_list_)}, type_counts_{rhs.type_counts_}, counts_stale_{rhs.counts_stale_}
+        {
+            rhs.recount();
         }
 
-        template<typename ... Us>
-        py_vector& operator=(const py_vector<Us...>& rhs)
+        // now, let's try some metaprogramming....
+        // NOTE: per "C++ Templates the Complete Guide, 2nd ed." (pp.102,103), this is necessary to force use
+        // of customized copy ctor.
+        
+        basic_py_vector(basic_py_vector const volatile& rhs) = delete;
+
+        template<typename S, typename ... Us>
+        explicit basic_py_vector(const basic_py_vector<S, Us...>& rhs)
         {
+            // now, make sure the we have all the types the class we are copying from does.
+            //
             if constexpr(std::is_same_v<mp11::mp_size<mp11::mp_set_intersection<new_types_set_<Ts...>,
                     new_types_set_<Us...>>>, mp11::mp_size<new_types_set_<Us...>>>)
             {
@@ -317,24 +602,865 @@ class py_vector
                 // our own type of variant elements which, thanks to check above, we know can handle
                 // all the types possible in rhs.
                
-                // a little bit of exception safety.
-                
-                pylist_t new_values;
+                append_translated(the_list_, rhs.the_list_);
+                this->note_filled(the_list_);
+                count_from(0);
+            }
+            else
+            {
+                // just use this to get a more understandable compile error if our type signatures at not compatible.
+               
+                static_assert(std::is_same_v<std::true_type, std::false_type>,
+                        "rhs py_vector type signature must be proper subset to copy construct.");
+            }
+
+        }
+
+        // make an owning copy of what a view sees.
+
+        template<typename Iterator>
+        explicit basic_py_vector(const py_vector_view<Iterator>& rhs)
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_rename<typename py_vector_view<Iterator>::value_type, mp11::mp_list>>,
+                    "view's type signature must be proper subset to copy construct.");
+            append_translated(the_list_, rhs.begin(), rhs.end());
+            this->note_filled(the_list_);
+            count_from(0);
+        }
+
+        // the elements of rhs are moved, not copied, and rhs is left empty.
+
+        template<typename S, typename ... Us>
+        explicit basic_py_vector(basic_py_vector<S, Us...>&& rhs)
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>,
+                    "rhs py_vector type signature must be proper subset to move construct.");
+            append_translated(the_list_, std::make_move_iterator(rhs.the_list_.begin()), std::make_move_iterator(rhs.the_list_.end()));
+            rhs.the_list_.clear();
+            rhs.recount();
+            count_from(0);
+        }
+
+        template<typename, typename ...> friend class basic_py_vector;
+
+        /* ====================  ACCESSORS     ======================================= */
+
+        auto size() const { return the_list_.size(); }
+        auto begin() const { return the_list_.begin(); }
+        auto cbegin() const { return the_list_.cbegin(); }
+        auto end() const { return the_list_.end(); }
+        auto cend() const { return the_list_.cend(); }
+        auto empty() const { return  the_list_.empty(); }
+
+        allocator_type get_allocator() const { return the_list_.get_allocator(); }
+
+        // output is formatted into a buffer with std::to_chars then written in one go.
+        // With options.repr, strings and chars are quoted like Python's repr().
+
+        void print_list(std::ostream& out, const cpp_like_py::format_options& options = {}) const
+        {
+            cpp_like_py::print_elements(out, the_list_.cbegin(), the_list_.cend(), options);
+        }
+
+        [[nodiscard]] std::string to_string(const cpp_like_py::format_options& options = {}) const
+        {
+            cpp_like_py::format_buffer buffer;
+            format_to(buffer, options);
+            return buffer.release();
+        }
+
+        // appends to 'buffer' so one buffer can be reused for many lists.
+
+        void format_to(cpp_like_py::format_buffer& buffer, const cpp_like_py::format_options& options = {}) const
+        {
+            cpp_like_py::format_elements(buffer, the_list_.cbegin(), the_list_.cend(), options);
+        }
+
+        // straight to a file descriptor, in large blocks, no ostream involved.
+
+        void write_list(int fd, const cpp_like_py::format_options& options = {}) const
+        {
+            cpp_like_py::write_elements(fd, the_list_.cbegin(), the_list_.cend(), options);
+        }
+
+        // half open range, like Python's x[lower:upper].  Negative bounds count back
+        // from the end and bounds past either end are pulled back in.
+
+        basic_py_vector slice(int lower_bound, int upper_bound) const
+        {
+            return slice(py_slice{lower_bound, upper_bound});
+        }
+
+        // a copy of the elements 'where' picks out.
+
+        basic_py_vector slice(const py_slice& where) const
+        {
+            basic_py_vector result{empty_like()};
+            if constexpr(cpp_like_py::container_shares_slices<pylist_t>::value)
+            {
+                if (const auto resolved = where.resolve(the_list_.size()); resolved.step == 1)
+                {
+                    // counting the slice's types would cost what sharing saved.
+
+                    result.the_list_ = the_list_.share(resolved.start, resolved.count);
+                    result.counts_stale_ = true;
+                    return result;
+                }
+            }
+            const auto elements = view(where);
+            append_translated(result.the_list_, elements.begin(), elements.end());
+            result.count_from(0);
+            return result;
+        }
+
+        // Python's sorted(x): a sorted copy, same arguments as sort().
+
+        template<typename ...Args>
+        [[nodiscard]] basic_py_vector sorted(Args&&... args) const
+        {
+            basic_py_vector result{*this};
+            result.sort(std::forward<Args>(args)...);
+            return result;
+        }
+
+        // same elements as slice() but nothing is copied.  The view sees changes made
+        // to our elements and is no good after we are resized.
+
+        py_vector_view<typename pylist_t::const_iterator> view(const py_slice& where = {}) const
+        {
+            const auto resolved = where.resolve(the_list_.size());
+            return {the_list_.cbegin() + (resolved.count == 0 ? 0 : resolved.start), resolved.step, resolved.count};
+        }
+
+        py_vector_view<typename pylist_t::iterator> view(const py_slice& where = {})
+        {
+            counts_stale_ = true;
+            const auto resolved = where.resolve(the_list_.size());
+            return {the_list_.begin() + (resolved.count == 0 ? 0 : resolved.start), resolved.step, resolved.count};
+        }
+
+        template<typename Y>
+        bool contains(const Y& item) const
+        {
+            return index_of(item).has_value();
+        }
+
+        // Python's list.index() and list.count().  index_of gives back nothing
+        // where Python would raise a ValueError.
+
+        template<typename Y>
+        std::optional<std::size_t> index_of(const Y& item) const
+        {
+            auto pos = std::find_if(the_list_.cbegin(), the_list_.cend(),
+                    [&item](const value_type& elem) { return cpp_like_py::holds_equal(elem, item); });
+            if (pos == the_list_.cend())
+            {
+                this->note_scan(the_list_.size());
+                return std::nullopt;
+            }
+            this->note_scan(static_cast<std::size_t>(pos - the_list_.cbegin()) + 1);
+            return static_cast<std::size_t>(pos - the_list_.cbegin());
+        }
+
+        template<typename Y>
+        std::size_t count(const Y& item) const
+        {
+            this->note_scan(the_list_.size());
+            return std::count_if(the_list_.cbegin(), the_list_.cend(),
+                    [&item](const value_type& elem) { return cpp_like_py::holds_equal(elem, item); });
+        }
+
+        // how many of our elements are a T.  We keep a count per alternative as the list
+        // changes so this doesn't look at the elements.  The exception is after a
+        // non-const operator[] or view(), which let an element change type behind our
+        // back.  Then the elements are counted again, once.
+
+        template<typename T>
+        std::size_t count_of() const
+        {
+            static_assert(mp11::mp_contains<new_types_set_<Ts...>, T>::value, "Type T must be in type signature of py_vector.");
+
+            const auto counts = counts_stale_ ? count_types() : type_counts_;
+            std::size_t result{0};
+            mp11::mp_for_each<mp11::mp_iota_c<sizeof...(Ts)>>([&](auto I)
+            {
+                if constexpr(std::is_same_v<T, std::variant_alternative_t<I, value_type>>)
+                {
+                    result += counts[I];
+                }
+            });
+            return result;
+        }
+
+        template<typename T>
+        std::size_t count_of()
+        {
+            if (counts_stale_)
+            {
+                recount();
+            }
+            return std::as_const(*this).template count_of<T>();
+        }
+
+        // copies of our elements of type T, in list order, as a plain array for code which
+        // wants a column of numbers.  extract_into appends to 'out' so one vector can be
+        // reused batch after batch.
+
+        template<typename T>
+        [[nodiscard]] std::vector<T> extract() const
+        {
+            std::vector<T> result;
+            extract_into<T>(result);
+            return result;
+        }
+
+        template<typename T, typename Allocator>
+        void extract_into(std::vector<T, Allocator>& out) const
+        {
+            static_assert(mp11::mp_contains<new_types_set_<Ts...>, T>::value, "Type T must be in type signature of py_vector.");
+
+            const std::size_t old_size = out.size();
+            const std::size_t how_many = count_of<T>();
+            if (how_many == 0)
+            {
+                return;
+            }
+
+            if constexpr(std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>
+                    && mp11::mp_count<mp11::mp_list<Ts...>, T>::value == 1)
+            {
+                // no branch on the element type.  Every element writes something to the
+                // next slot, only a T moves past it.  So a list with its types mixed
+                // together costs no more than one with them in runs.  We stop at the
+                // last T so nothing is written past the end of 'out'.
+
+                constexpr std::size_t I = alternative_for<T>();
+                auto last = the_list_.cend();
+                while ((last - 1)->index() != I)
+                {
+                    --last;
+                }
+
+                out.resize(old_size + how_many);
+                T* next = out.data() + old_size;
+                for (auto elem = the_list_.cbegin(); elem != last; ++elem)
+                {
+                    const T* x = std::get_if<I>(&*elem);
+                    *next = x != nullptr ? *x : T{};
+                    next += (x != nullptr);
+                }
+            }
+            else
+            {
+                out.reserve(old_size + how_many);
+                for (const auto& elem : the_list_)
+                {
+                    apply_to_alternative<T>(elem, [&out](const T& x) { out.push_back(x); });
+                }
+            }
+        }
+
+        // this method will apply the supplied function to all list elements
+        // of the specified type.
+        
+        template<typename T, class F>
+        void visit_all(F& func)
+        {
+            using good_type = mp11::mp_contains<new_types_set_<Ts...>, T>;
+            static_assert(std::is_same_v<good_type, mp11::mp_true>, "Type T must be in type signature of py_vector.");
+            this->note_visit(mp11::mp_find<mp11::mp_list<Ts...>, T>::value);
+
+            auto apply_func([func](auto& elem)
+            {
+                // we the index here rather than type since we can have multiple
+                // instances of a type in our type signature.
                 
-                auto copy_value([&new_values](const auto& e)
+                mp11::mp_with_index<sizeof...(Ts)>(elem.index(), [&](auto I)
+                {
+                    using X = std::variant_alternative_t<I, std::variant<Ts ...>>;
+                    if constexpr (std::is_same_v<T, X>)
+                    {
+                        // we take a reference here because we may
+                        // modify the values in our list.
+                        
+                        X& x = std::get<I>(elem);
+                        func(x);
+                    }
+                });
+            });
+            std::for_each(the_list_.begin(), the_list_.end(), apply_func);
+        }
+
+        // lazy version: a pipeline over our elements of type T, as T&.  Follow it with
+        // filter, map, etc. from py_pipeline.h and finish with one of the to_ methods.
+
+        template<typename T>
+        auto of_type()
+        {
+            static_assert(mp11::mp_contains<new_types_set_<Ts...>, T>::value, "Type T must be in type signature of py_vector.");
+            return cpp_like_py::of_type<T>(the_list_.begin(), the_list_.end(), count_of<T>());
+        }
+
+        template<typename T>
+        auto of_type() const
+        {
+            static_assert(mp11::mp_contains<new_types_set_<Ts...>, T>::value, "Type T must be in type signature of py_vector.");
+            return cpp_like_py::of_type<T>(the_list_.cbegin(), the_list_.cend(), count_of<T>());
+        }
+
+        // the same, but with seq or par from parallel_chunks.h.  With par, the list is split
+        // into chunks which are visited on several threads at once so func has to be safe
+        // to call concurrently.  Each element is still visited exactly once.
+
+        template<typename T, class ExecutionPolicy, class F,
+            typename = std::enable_if_t<cpp_like_py::execution::is_execution_policy_v<ExecutionPolicy>>>
+        void visit_all(ExecutionPolicy&& policy, F&& func)
+        {
+            static_assert(mp11::mp_contains<new_types_set_<Ts...>, T>::value, "Type T must be in type signature of py_vector.");
+            this->note_visit(mp11::mp_find<mp11::mp_list<Ts...>, T>::value);
+
+            // taken once, up front, since some storage does work to hand out a
+            // non-const iterator and we may be about to split across threads.
+
+            const auto elements = the_list_.begin();
+            for_each_index(policy, [&](std::size_t i)
+            {
+                apply_to_alternative<T>(elements[i], func);
+            });
+        }
+
+        // replaces each element of type T with func(element).  Like Python's map(), the
+        // result doesn't have to be a T, the element becomes whatever func returns as long
+        // as that is in our type signature.
+
+        template<typename T, class F>
+        void transform_all(F&& func)
+        {
+            transform_all<T>(cpp_like_py::execution::seq, std::forward<F>(func));
+        }
+
+        template<typename T, class ExecutionPolicy, class F,
+            typename = std::enable_if_t<cpp_like_py::execution::is_execution_policy_v<ExecutionPolicy>>>
+        void transform_all(ExecutionPolicy&& policy, F&& func)
+        {
+            static_assert(mp11::mp_contains<new_types_set_<Ts...>, T>::value, "Type T must be in type signature of py_vector.");
+            using R = std::decay_t<std::invoke_result_t<F&, T&>>;
+            static_assert(mp11::mp_contains<new_types_set_<Ts...>, R>::value, "func must return a type in the type signature of py_vector.");
+
+            const auto elements = the_list_.begin();
+            for_each_index(policy, [&](std::size_t i)
+            {
+                auto& elem = elements[i];
+                mp11::mp_with_index<sizeof...(Ts)>(elem.index(), [&](auto I)
+                {
+                    using X = std::variant_alternative_t<I, value_type>;
+                    if constexpr (std::is_same_v<T, X>)
+                    {
+                        if constexpr (std::is_same_v<R, X>)
+                        {
+                            X& x = std::get<I>(elem);
+                            x = func(x);
+                        }
+                        else
+                        {
+                            // the argument is built before emplace destroys the old value.
+
+                            elem.template emplace<mp11::mp_find<mp11::mp_list<Ts...>, R>::value>(func(std::get<I>(elem)));
+                        }
+                    }
+                });
+            });
+
+            // every T became an R.
+
+            mp11::mp_for_each<mp11::mp_iota_c<sizeof...(Ts)>>([&](auto I)
+            {
+                if constexpr(std::is_same_v<T, std::variant_alternative_t<I, value_type>> && ! std::is_same_v<T, R>)
+                {
+                    type_counts_[mp11::mp_find<mp11::mp_list<Ts...>, R>::value] += type_counts_[I];
+                    type_counts_[I] = 0;
+                }
+            });
+        }
+
+        // folds the elements of type T into 'init', in list order: op(op(init, a), b)...
+        // op takes (Acc, T) and returns an Acc.
+
+        template<typename T, typename Acc, class Op>
+        Acc reduce_all(Acc init, Op op) const
+        {
+            return reduce_all<T>(cpp_like_py::execution::seq, std::move(init), op);
+        }
+
+        template<typename T, class ExecutionPolicy, typename Acc, class Op,
+            typename = std::enable_if_t<cpp_like_py::execution::is_execution_policy_v<ExecutionPolicy>>>
+        Acc reduce_all(ExecutionPolicy&&, Acc init, Op op) const
+        {
+            static_assert(std::is_same_v<std::decay_t<ExecutionPolicy>, cpp_like_py::execution::sequenced_policy>,
+                "with par, reduce_all needs an identity and a combine op as well.");
+            return fold_all<T>(std::move(init), op, 0, the_list_.size());
+        }
+
+        // with par, each chunk is folded separately, starting from a copy of 'identity',
+        // then the chunk results are folded into 'init' in list order with
+        // combine(Acc, Acc).  So combine has to be associative and 'identity' has to
+        // change nothing, but neither has to be commutative, and since the chunks don't
+        // depend on the number of threads, the answer is always the same.
+
+        template<typename T, class ExecutionPolicy, typename Acc, class Op, class Combine,
+            typename = std::enable_if_t<cpp_like_py::execution::is_execution_policy_v<ExecutionPolicy>>>
+        Acc reduce_all(ExecutionPolicy&& policy, Acc init, const Acc& identity, Op op, Combine combine) const
+        {
+            if constexpr (std::is_same_v<std::decay_t<ExecutionPolicy>, cpp_like_py::execution::sequenced_policy>
+                || cpp_like_py::container_is_single_threaded<pylist_t>::value)
+            {
+                return fold_all<T>(std::move(init), op, 0, the_list_.size());
+            }
+            else
+            {
+                std::vector<Acc> partials(cpp_like_py::chunk_count(policy, the_list_.size()), identity);
+                cpp_like_py::for_each_chunk(policy, the_list_.size(), [&](std::size_t chunk, std::size_t first, std::size_t last)
+                {
+                    partials[chunk] = fold_all<T>(std::move(partials[chunk]), op, first, last);
+                });
+
+                for (auto& partial : partials)
+                {
+                    init = combine(std::move(init), std::move(partial));
+                }
+                return init;
+            }
+        }
+
+        // bulk numeric operations on the arithmetic alternatives of our type signature.
+        // Our elements aren't contiguous so they are changed where they are, one at a
+        // time.  Copying them out to run the SIMD kernels and back again costs more than
+        // the kernels save.
+
+        template<typename T>
+        void scale_all(T factor)
+        {
+            static_assert(cpp_like_py::is_py_numeric_v<T>, "Type T must be a numeric type.");
+            for_each_of_type<T>([factor](T& x) { x *= factor; });
+        }
+
+        template<typename T>
+        void add_all(T value)
+        {
+            static_assert(cpp_like_py::is_py_numeric_v<T>, "Type T must be a numeric type.");
+            for_each_of_type<T>([value](T& x) { x += value; });
+        }
+
+        template<typename T>
+        void clamp_all(T low, T high)
+        {
+            static_assert(cpp_like_py::is_py_numeric_v<T>, "Type T must be a numeric type.");
+            for_each_of_type<T>([low, high](T& x) { x = std::min(std::max(x, low), high); });
+        }
+
+        // these look at all the numeric elements in the list and skip everything else.
+        // sum() is an int unless there is a float in the list, just like Python.
+
+        [[nodiscard]] cpp_like_py::py_number sum() const
+        {
+            return cpp_like_py::sum_of_blocks([this](auto&& func) { this->for_each_numeric_block(func); });
+        }
+
+        [[nodiscard]] double mean() const
+        {
+            return cpp_like_py::mean_of_blocks([this](auto&& func) { this->for_each_numeric_block(func); });
+        }
+
+        [[nodiscard]] value_type min() const
+        {
+            return cpp_like_py::extreme_of_blocks<value_type, false>([this](auto&& func) { this->for_each_numeric_block(func); });
+        }
+
+        [[nodiscard]] value_type max() const
+        {
+            return cpp_like_py::extreme_of_blocks<value_type, true>([this](auto&& func) { this->for_each_numeric_block(func); });
+        }
+
+        /* ====================  MUTATORS      ======================================= */
+        
+        basic_py_vector& append(const basic_py_vector& rhs)
+        {
+            [[maybe_unused]] const auto watch = this->watch_growth(the_list_);
+            if (this != & rhs)
+            {
+                const auto old_size = the_list_.size();
+                append_translated(the_list_, rhs.the_list_);
+                count_from(old_size);
+            }
+            return *this;
+        }
+
+        basic_py_vector& append(std::initializer_list<value_type> new_values)
+        {
+            [[maybe_unused]] const auto watch = this->watch_growth(the_list_);
+            const auto old_size = the_list_.size();
+            append_translated(the_list_, new_values.begin(), new_values.end());
+            count_from(old_size);
+            return *this;
+        }
+
+        basic_py_vector& append(basic_py_vector&& rhs)
+        {
+            [[maybe_unused]] const auto watch = this->watch_growth(the_list_);
+            if (this != &rhs)
+            {
+                const auto old_size = the_list_.size();
+                append_translated(the_list_, std::make_move_iterator(rhs.the_list_.begin()), std::make_move_iterator(rhs.the_list_.end()));
+                rhs.the_list_.clear();
+                rhs.recount();
+                count_from(old_size);
+            }
+            return *this;
+        }
+
+        // a single element.  rvalues are moved into the list.
+
+        template<typename T, typename = std::enable_if_t<! cpp_like_py::is_basic_py_vector_v<T>>>
+        basic_py_vector& append(T&& element)
+        {
+            [[maybe_unused]] const auto watch = this->watch_growth(the_list_);
+            emplace_alternative<alternative_for<T>()>(the_list_, std::forward<T>(element));
+            ++type_counts_[alternative_for<T>()];
+            return *this;
+        }
+
+        // builds the new element in place from 'args'.
+
+        template<typename T, typename ...Args>
+        T& emplace(Args&& ...args)
+        {
+            [[maybe_unused]] const auto watch = this->watch_growth(the_list_);
+            constexpr std::size_t I = alternative_for<T>();
+            emplace_alternative<I>(the_list_, std::forward<Args>(args)...);
+            ++type_counts_[I];
+            return *std::get_if<I>(&the_list_.back());
+        }
+
+        // Python's list.insert(): 'index' counts back from the end if negative and
+        // anything past either end just goes on that end.
+
+        template<typename T, typename ...Args>
+        T& emplace_at(std::ptrdiff_t index, Args&& ...args)
+        {
+            [[maybe_unused]] const auto watch = this->watch_growth(the_list_);
+            constexpr std::size_t I = alternative_for<T>();
+            auto where = emplace_alternative_at<I>(the_list_, the_list_.begin() + insert_position(index), std::forward<Args>(args)...);
+            ++type_counts_[I];
+            return *std::get_if<I>(&*where);
+        }
+
+        template<typename T>
+        basic_py_vector& insert(std::ptrdiff_t index, T&& element)
+        {
+            emplace_at<std::decay_t<T>>(index, std::forward<T>(element));
+            return *this;
+        }
+
+        // Python's list.extend().  Everything is reserved up front.  From an rvalue,
+        // the elements are moved and rhs is left empty.
+
+        template<typename S, typename ...Us>
+        basic_py_vector& extend(const basic_py_vector<S, Us...>& rhs)
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>,
+                    "rhs py_vector type signature must be proper subset to extend.");
+            [[maybe_unused]] const auto watch = this->watch_growth(the_list_);
+            if (static_cast<const void*>(this) == static_cast<const void*>(&rhs))
+            {
+                // Python lets you extend a list with itself.
+
+                // by position since adding elements may move the ones we are copying.
+
+                the_list_.reserve(the_list_.size() * 2);
+                const auto old_size = the_list_.size();
+                for (std::size_t i = 0; i < old_size; ++i)
+                {
+                    mp11::mp_with_index<sizeof...(Ts)>(the_list_[i].index(), [&](auto I)
+                    {
+                        emplace_alternative<I>(the_list_, *std::get_if<I>(&the_list_[i]));
+                    });
+                }
+                count_from(old_size);
+                return *this;
+            }
+            const auto old_size = the_list_.size();
+            append_translated(the_list_, rhs.the_list_);
+            count_from(old_size);
+            return *this;
+        }
+
+        template<typename S, typename ...Us>
+        basic_py_vector& extend(basic_py_vector<S, Us...>&& rhs)
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>,
+                    "rhs py_vector type signature must be proper subset to extend.");
+            [[maybe_unused]] const auto watch = this->watch_growth(the_list_);
+            if (static_cast<const void*>(this) != static_cast<const void*>(&rhs))
+            {
+                const auto old_size = the_list_.size();
+                append_translated(the_list_, std::make_move_iterator(rhs.the_list_.begin()), std::make_move_iterator(rhs.the_list_.end()));
+                rhs.the_list_.clear();
+                rhs.recount();
+                count_from(old_size);
+            }
+            return *this;
+        }
+
+        // any other range.  Its elements can be variants our elements can hold or plain
+        // values of a type in our type signature.
+
+        template<typename Iterator>
+        basic_py_vector& extend(Iterator first, Iterator last)
+        {
+            [[maybe_unused]] const auto watch = this->watch_growth(the_list_);
+            using source_t = typename std::iterator_traits<Iterator>::value_type;
+            const auto old_size = the_list_.size();
+
+            if constexpr(cpp_like_py::is_variant_v<source_t>)
+            {
+                static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_rename<source_t, mp11::mp_list>>,
+                        "range's type signature must be proper subset to extend.");
+                append_translated(the_list_, first, last);
+            }
+            else
+            {
+                if constexpr(std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>)
+                {
+                    the_list_.reserve(the_list_.size() + static_cast<std::size_t>(std::distance(first, last)));
+                }
+                for (; first != last; ++first)
+                {
+                    emplace_alternative<alternative_for<source_t>()>(the_list_, *first);
+                }
+            }
+            count_from(old_size);
+            return *this;
+        }
+
+        template<typename Range, typename = std::enable_if_t<! cpp_like_py::is_basic_py_vector_v<Range>>>
+        basic_py_vector& extend(Range&& range)
+        {
+            if constexpr(std::is_rvalue_reference_v<Range&&>)
+            {
+                return extend(std::make_move_iterator(std::begin(range)), std::make_move_iterator(std::end(range)));
+            }
+            else
+            {
+                return extend(std::begin(range), std::end(range));
+            }
+        }
+
+        // Python's list.pop().  Takes the element out of the list and gives it back.
+        // Python raises an IndexError for a bad index, we throw std::out_of_range.
+
+        value_type pop(std::ptrdiff_t index = -1)
+        {
+            const auto size = static_cast<std::ptrdiff_t>(the_list_.size());
+            if (index < 0)
+            {
+                index += size;
+            }
+            if (index < 0 || index >= size)
+            {
+                throw std::out_of_range{"pop index out of range"};
+            }
+            value_type result{std::move(the_list_[index])};
+            the_list_.erase(the_list_.begin() + index);
+            --type_counts_[result.index()];
+            return result;
+        }
+
+        // not something Python needs but if we know how many elements are coming,
+        // we can skip the reallocations.
+
+        void reserve(std::size_t new_capacity)
+        {
+            [[maybe_unused]] const auto watch = this->watch_growth(the_list_);
+            the_list_.reserve(new_capacity);
+        }
+
+        // half open range
+
+        basic_py_vector& erase(std::size_t from, std::size_t to)
+        {
+            for (std::size_t i = from; i < to; ++i)
+            {
+                --type_counts_[the_list_[i].index()];
+            }
+            the_list_.erase(the_list_.begin() + from, the_list_.begin() + to);
+            return *this;
+        }
+
+        // Python 3 won't compare an int with a str.  We sort by type first, in type
+        // signature order, then by value.  Floating point values are in IEEE total order
+        // so NaNs go at the ends instead of breaking the sort.
+        //
+        // The elements are grouped by type, then each group is unwrapped into a plain
+        // array, sorted (radix sort for integers and floats) and put back.
+
+        basic_py_vector& sort(bool reverse = false)
+        {
+            return sort(cpp_like_py::execution::seq, reverse);
+        }
+
+        template<class ExecutionPolicy,
+            typename = std::enable_if_t<cpp_like_py::execution::is_execution_policy_v<ExecutionPolicy>>>
+        basic_py_vector& sort(ExecutionPolicy&& policy, bool reverse = false)
+        {
+            sort_by_type(policy, false, reverse);
+            return *this;
+        }
+
+        // Python's list.sort(key=..., reverse=...).  'key' is called once per element and
+        // the keys are compared with operator<.  Elements with equal keys keep their order.
+
+        template<typename Key, typename = std::enable_if_t<std::is_invocable_v<Key&, const value_type&>>>
+        basic_py_vector& sort(Key key, bool reverse = false)
+        {
+            using K = std::decay_t<std::invoke_result_t<Key&, const value_type&>>;
+
+            std::vector<K> keys;
+            keys.reserve(the_list_.size());
+            for (const auto& elem : the_list_)
+            {
+                keys.push_back(key(elem));
+            }
+
+            std::vector<std::size_t> order(the_list_.size());
+            std::iota(order.begin(), order.end(), std::size_t{0});
+            if (reverse)
+            {
+                std::stable_sort(order.begin(), order.end(), [&keys](std::size_t a, std::size_t b) { return keys[b] < keys[a]; });
+            }
+            else
+            {
+                std::stable_sort(order.begin(), order.end(), [&keys](std::size_t a, std::size_t b) { return keys[a] < keys[b]; });
+            }
+            apply_order(order);
+            return *this;
+        }
+
+        // same order as sort() but elements which compare equal keep their order.
+
+        basic_py_vector& stable_sort(bool reverse = false)
+        {
+            return stable_sort(cpp_like_py::execution::seq, reverse);
+        }
+
+        template<class ExecutionPolicy,
+            typename = std::enable_if_t<cpp_like_py::execution::is_execution_policy_v<ExecutionPolicy>>>
+        basic_py_vector& stable_sort(ExecutionPolicy&& policy, bool reverse = false)
+        {
+            sort_by_type(policy, true, reverse);
+            return *this;
+        }
+
+        // moves the element which belongs at 'nth' in sort() order there.  Everything ahead of
+        // it sorts before it and everything after it doesn't, like std::nth_element.
+
+        basic_py_vector& nth_element(std::size_t nth)
+        {
+            if (nth >= the_list_.size())
+            {
+                throw std::out_of_range{"nth_element index out of range"};
+            }
+            const auto bounds = partition_by_type();
+
+            mp11::mp_for_each<mp11::mp_iota_c<sizeof...(Ts)>>([&](auto I)
+            {
+                if (nth >= bounds[I] && nth < bounds[I + 1])
+                {
+                    using X = std::variant_alternative_t<I, value_type>;
+                    auto less = cpp_like_py::kernels::value_less<X>();
+                    std::nth_element(the_list_.begin() + bounds[I], the_list_.begin() + nth, the_list_.begin() + bounds[I + 1],
+                        [&less, I](const value_type& a, const value_type& b) { return less(*std::get_if<I>(&a), *std::get_if<I>(&b)); });
+                }
+            });
+            return *this;
+        }
+
+        // groups the elements by type, in type signature order, keeping their order within
+        // each group.  Elements of alternative I end up in [result[I], result[I + 1]).
+
+        std::array<std::size_t, sizeof...(Ts) + 1> partition_by_type()
+        {
+            if (counts_stale_)
+            {
+                recount();
+            }
+            std::array<std::size_t, sizeof...(Ts) + 1> bounds{};
+            std::copy(type_counts_.begin(), type_counts_.end(), bounds.begin() + 1);
+            for (std::size_t i = 1; i < bounds.size(); ++i)
+            {
+                bounds[i] += bounds[i - 1];
+            }
+
+            const bool grouped = std::is_sorted(the_list_.begin(), the_list_.end(),
+                    [](const value_type& a, const value_type& b) { return a.index() < b.index(); });
+            if (! grouped)
+            {
+                auto next = bounds;
+                std::vector<std::size_t> order(the_list_.size());
+                for (std::size_t i = 0; i < the_list_.size(); ++i)
+                {
+                    order[next[the_list_[i].index()]++] = i;
+                }
+                apply_order(order);
+            }
+            return bounds;
+        }
+
+        /* ====================  OPERATORS     ======================================= */
+
+        basic_py_vector& operator=(const basic_py_vector& rhs)
+        {
+            if (this != &rhs)
+            {
+                if constexpr(propagates_allocator_)
                 {
-                    using X = std::remove_cv_t<std::remove_reference_t<decltype(e)>>;
-                    value_type new_elem{std::in_place_type<X>, e};
-                    new_values.push_back(new_elem);
-                 }); 
+                    // elementwise assignment could give us copies using the default allocator
+                    // when an element changes type.  Rebuild with our allocator instead.
 
-                for (const auto& r_element : rhs.the_list_)
+                    pylist_t new_values(empty_like().the_list_);
+                    append_translated(new_values, rhs.the_list_);
+                    std::swap(this->the_list_, new_values);
+                    this->note_filled(the_list_);
+                }
+                else
                 {
-                    std::visit(copy_value, r_element);
-                 
+                    [[maybe_unused]] const auto watch = this->watch_growth(the_list_);
+                    the_list_ = rhs.the_list_;
+                    this->note_copied(rhs.size(), sizeof(value_type));
                 }
+                type_counts_ = rhs.type_counts_;
+                counts_stale_ = rhs.counts_stale_;
+            }
+            return *this;
+        }
+
+        template<typename S, typename ... Us>
+        basic_py_vector& operator=(const basic_py_vector<S, Us...>& rhs)
+        {
+            if constexpr(std::is_same_v<mp11::mp_size<mp11::mp_set_intersection<new_types_set_<Ts...>,
+                    new_types_set_<Us...>>>, mp11::mp_size<new_types_set_<Us...>>>)
+            {
+                // we can not simply copy the variant elements from the rhs vector, we need to use
+                // our own type of variant elements which, thanks to check above, we know can handle
+                // all the types possible in rhs.
+               
+                // a little bit of exception safety.
+                
+                pylist_t new_values(empty_like().the_list_);
+                append_translated(new_values, rhs.the_list_);
 
                 std::swap(this->the_list_, new_values);
+                this->note_filled(the_list_);
+                recount();
                 return *this;
             }
             else
@@ -346,16 +1472,44 @@ class py_vector
             }
         }
 
-        py_vector& operator=(py_vector&& rhs) noexcept
+        template<typename S, typename ... Us>
+        basic_py_vector& operator=(basic_py_vector<S, Us...>&& rhs)
+        {
+            static_assert(types_are_subset_v<mp11::mp_list<Ts...>, mp11::mp_list<Us...>>,
+                    "rhs py_vector type signature must be proper subset to move assign.");
+
+            pylist_t new_values(empty_like().the_list_);
+            append_translated(new_values, std::make_move_iterator(rhs.the_list_.begin()), std::make_move_iterator(rhs.the_list_.end()));
+            std::swap(this->the_list_, new_values);
+            rhs.the_list_.clear();
+            rhs.recount();
+            recount();
+            return *this;
+        }
+
+        basic_py_vector& operator=(basic_py_vector&& rhs) noexcept(! propagates_allocator_)
         {
             if (this != &rhs)
             {
+                if constexpr(propagates_allocator_)
+                {
+                    // moved elements keep the allocator they came with so if rhs allocates
+                    // from somewhere else, we have to copy.
+
+                    if (the_list_.get_allocator() != rhs.the_list_.get_allocator())
+                    {
+                        return *this = static_cast<const basic_py_vector&>(rhs);
+                    }
+                }
                 the_list_ = std::move(rhs.the_list_);
+                type_counts_ = rhs.type_counts_;
+                counts_stale_ = rhs.counts_stale_;
+                rhs.recount();
             }
             return *this;
         }
 
-        py_vector& operator+=(const py_vector& rhs)
+        basic_py_vector& operator+=(const basic_py_vector& rhs)
         {
             if (this != &rhs)
             {
@@ -364,16 +1518,15 @@ class py_vector
             return *this;
         }
 
-        template<typename T>
-        py_vector& operator+=(const T& element)
+        template<typename T, typename = std::enable_if_t<! cpp_like_py::is_basic_py_vector_v<T>>>
+        basic_py_vector& operator+=(T&& element)
         {
-            value_type e{std::in_place_type<T>, element};
-            the_list_.push_back(e);
-            return *this;
+            return this->append(std::forward<T>(element));
         }
 
         value_type& operator[](int index)
         {
+            counts_stale_ = true;
             return the_list_[index];
         }
 
@@ -382,13 +1535,19 @@ class py_vector
             return the_list_[index];
         }
 
-        bool operator==(const py_vector& rhs) const
+        bool operator==(const basic_py_vector& rhs) const
         {
             return the_list_ == rhs.the_list_;
         }
-        
-        template<typename ... Us>
-        bool operator==(const py_vector<Us...>& rhs) const
+
+        template<typename Iterator>
+        bool operator==(const py_vector_view<Iterator>& rhs) const
+        {
+            return rhs == *this;
+        }
+
+        template<typename S, typename ... Us>
+        bool operator==(const basic_py_vector<S, Us...>& rhs) const
         {
             if constexpr(std::is_same_v<mp11::mp_size<mp11::mp_set_intersection<new_types_set_<Ts...>,
                     new_types_set_<Us...>>>, mp11::mp_size<new_types_set_<Us...>>>)
@@ -399,7 +1558,8 @@ class py_vector
                 {
                     return cpp_like_py::operator==(a, b);
                 });
-                return std::equal(the_list_.cbegin(), the_list_.cend(), rhs.the_list_.cbegin(), compare_elements);
+                return the_list_.size() == rhs.the_list_.size()
+                    && std::equal(the_list_.cbegin(), the_list_.cend(), rhs.the_list_.cbegin(), compare_elements);
             }
             else
             {
@@ -420,9 +1580,356 @@ class py_vector
     private:
         /* ====================  METHODS       ======================================= */
 
+        // calls func on elem if it holds a T.  We go by index rather than type since we
+        // can have multiple instances of a type in our type signature.
+
+        template<typename T, typename Elem, class F>
+        static void apply_to_alternative(Elem& elem, F&& func)
+        {
+            mp11::mp_with_index<sizeof...(Ts)>(elem.index(), [&](auto I)
+            {
+                using X = std::variant_alternative_t<I, value_type>;
+                if constexpr (std::is_same_v<T, X>)
+                {
+                    func(*std::get_if<I>(&elem));
+                }
+            });
+        }
+
+        // op(op(acc, a), b)... over the T's in [first, last).
+
+        template<typename T, typename Acc, class Op>
+        Acc fold_all(Acc acc, Op& op, std::size_t first, std::size_t last) const
+        {
+            static_assert(mp11::mp_contains<new_types_set_<Ts...>, T>::value, "Type T must be in type signature of py_vector.");
+            for (std::size_t i = first; i < last; ++i)
+            {
+                apply_to_alternative<T>(the_list_[i], [&acc, &op](const T& x) { acc = op(std::move(acc), x); });
+            }
+            return acc;
+        }
+
+        // runs func(i) for every position in the list, either in order or spread
+        // across threads a chunk at a time.
+
+        template<class ExecutionPolicy, class F>
+        void for_each_index(const ExecutionPolicy& policy, F&& func) const
+        {
+            if constexpr (std::is_same_v<ExecutionPolicy, cpp_like_py::execution::sequenced_policy>
+                || cpp_like_py::container_is_single_threaded<pylist_t>::value)
+            {
+                for (std::size_t i = 0; i < the_list_.size(); ++i)
+                {
+                    func(i);
+                }
+            }
+            else
+            {
+                cpp_like_py::for_each_chunk(policy, the_list_.size(), [&func](std::size_t, std::size_t first, std::size_t last)
+                {
+                    for (std::size_t i = first; i < last; ++i)
+                    {
+                        func(i);
+                    }
+                });
+            }
+        }
+
+        // copy the elements of a list with a compatible type signature onto the end of 'dest'
+        // in one reserved pass.  The translation table gives us, at compile time, the alternative
+        // which takes each of theirs so we can construct elements in place.  We dispatch once
+        // per run of elements with the same alternative rather than once per element.
+
+        template<typename Iterator>
+        static void append_translated(pylist_t& dest, Iterator first, Iterator last)
+        {
+            using source_t = typename std::iterator_traits<Iterator>::value_type;
+            using to_ours = cpp_like_py::alternative_translation<mp11::mp_list<Ts...>, mp11::mp_rename<source_t, mp11::mp_list>>;
+
+            // counting the elements of a single pass range would use them up.
+
+            if constexpr(std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>)
+            {
+                dest.reserve(dest.size() + static_cast<std::size_t>(std::distance(first, last)));
+            }
+
+            while (first != last)
+            {
+                mp11::mp_with_index<std::variant_size_v<source_t>>(first->index(), [&](auto J)
+                {
+                    constexpr std::size_t I = to_ours::value[J];
+                    do
+                    {
+                        // from a move_iterator, we get to take the value.
+
+                        auto&& source = *first;
+                        if constexpr(std::is_rvalue_reference_v<decltype(source)>)
+                        {
+                            emplace_alternative<I>(dest, std::move(*std::get_if<J>(&source)));
+                        }
+                        else
+                        {
+                            emplace_alternative<I>(dest, *std::get_if<J>(&source));
+                        }
+                        ++first;
+                    } while (first != last && first->index() == J);
+                });
+            }
+        }
+
+        template<typename Container>
+        static void append_translated(pylist_t& dest, const Container& source)
+        {
+            append_translated(dest, source.cbegin(), source.cend());
+        }
+
+        // construct alternative I on the end of 'dest'.  If our storage policy asks for it,
+        // alternatives which can use our allocator get it so everything in the list comes
+        // from the same place.
+
+        static constexpr bool propagates_allocator_ = cpp_like_py::storage_propagates_allocator<Storage>::value;
+
+        template<std::size_t I, typename ...Args>
+        static void emplace_alternative(pylist_t& dest, Args&& ...args)
+        {
+            construct_alternative<I>(dest, [&dest](auto&& ...all_args)
+            {
+                dest.emplace_back(std::forward<decltype(all_args)>(all_args)...);
+            }, std::forward<Args>(args)...);
+        }
+
+        // the same, but at 'where'.  Returns where the new element ended up.
+
+        template<std::size_t I, typename ...Args>
+        static auto emplace_alternative_at(pylist_t& dest, typename pylist_t::iterator where, Args&& ...args)
+        {
+            typename pylist_t::iterator result;
+            construct_alternative<I>(dest, [&dest, &result, where](auto&& ...all_args)
+            {
+                result = dest.emplace(where, std::forward<decltype(all_args)>(all_args)...);
+            }, std::forward<Args>(args)...);
+            return result;
+        }
+
+        template<std::size_t I, typename Place, typename ...Args>
+        static void construct_alternative(pylist_t& dest, Place&& place, Args&& ...args)
+        {
+            using X = std::variant_alternative_t<I, value_type>;
+
+            if constexpr(propagates_allocator_ && std::uses_allocator_v<X, allocator_type>)
+            {
+                if constexpr(std::is_constructible_v<X, Args..., const allocator_type&>)
+                {
+                    place(std::in_place_index<I>, std::forward<Args>(args)..., dest.get_allocator());
+                }
+                else
+                {
+                    place(std::in_place_index<I>, std::allocator_arg, dest.get_allocator(), std::forward<Args>(args)...);
+                }
+            }
+            else
+            {
+                place(std::in_place_index<I>, std::forward<Args>(args)...);
+            }
+        }
+
+        // the alternative which takes a T: the first one of that type.
+
+        template<typename T>
+        static constexpr std::size_t alternative_for()
+        {
+            using X = std::decay_t<T>;
+            static_assert(mp11::mp_contains<mp11::mp_list<Ts...>, X>::value, "Type T must be in type signature of py_vector.");
+            return mp11::mp_find<mp11::mp_list<Ts...>, X>::value;
+        }
+
+        // where Python's list.insert() puts things.
+
+        std::size_t insert_position(std::ptrdiff_t index) const
+        {
+            const auto size = static_cast<std::ptrdiff_t>(the_list_.size());
+            if (index < 0)
+            {
+                index += size;
+            }
+            return static_cast<std::size_t>(std::clamp<std::ptrdiff_t>(index, 0, size));
+        }
+
+        // rearranges our elements so the new i'th element is the old order[i]'th.
+
+        void apply_order(const std::vector<std::size_t>& order)
+        {
+            pylist_t new_values(empty_like().the_list_);
+            new_values.reserve(the_list_.size());
+            for (const auto i : order)
+            {
+                new_values.push_back(std::move(the_list_[i]));
+            }
+            std::swap(the_list_, new_values);
+        }
+
+        template<typename ExecutionPolicy>
+        void sort_by_type(const ExecutionPolicy& policy, bool stable, bool reverse)
+        {
+            const auto bounds = partition_by_type();
+
+            mp11::mp_for_each<mp11::mp_iota_c<sizeof...(Ts)>>([&](auto I)
+            {
+                using X = std::variant_alternative_t<I, value_type>;
+                if (bounds[I + 1] - bounds[I] < 2)
+                {
+                    return;
+                }
+
+                std::vector<X> values;
+                values.reserve(bounds[I + 1] - bounds[I]);
+                for (std::size_t i = bounds[I]; i < bounds[I + 1]; ++i)
+                {
+                    values.push_back(std::move(*std::get_if<I>(&the_list_[i])));
+                }
+                cpp_like_py::kernels::sort_values(policy, values, stable, reverse);
+                for (std::size_t i = bounds[I]; i < bounds[I + 1]; ++i)
+                {
+                    *std::get_if<I>(&the_list_[i]) = std::move(values[i - bounds[I]]);
+                }
+            });
+
+            if (reverse)
+            {
+                // each group is already sorted backwards with equal elements in their
+                // original order, as Python's reverse=True has them.  Just the order of
+                // the groups is left to turn around: reversing everything, then each
+                // group again, leaves the groups as they were.
+
+                std::reverse(the_list_.begin(), the_list_.end());
+                const auto size = the_list_.size();
+                for (std::size_t which = 0; which < sizeof...(Ts); ++which)
+                {
+                    std::reverse(the_list_.begin() + (size - bounds[which + 1]), the_list_.begin() + (size - bounds[which]));
+                }
+            }
+        }
+
+        // keeping type_counts_ up to date.  Elements appended to the list are counted
+        // after the fact, from their position on, since the append itself may go through
+        // append_translated which works on any list.
+
+        void count_from(std::size_t first)
+        {
+            for (std::size_t i = first; i < the_list_.size(); ++i)
+            {
+                ++type_counts_[the_list_[i].index()];
+            }
+        }
+
+        std::array<std::size_t, sizeof...(Ts)> count_types() const
+        {
+            std::array<std::size_t, sizeof...(Ts)> result{};
+            for (const auto& elem : the_list_)
+            {
+                ++result[elem.index()];
+            }
+            return result;
+        }
+
+        void recount()
+        {
+            type_counts_ = count_types();
+            counts_stale_ = false;
+        }
+
+        // an empty list which allocates the same way we do.
+
+        basic_py_vector empty_like() const
+        {
+            if constexpr(std::is_constructible_v<pylist_t, const allocator_type&>)
+            {
+                return basic_py_vector{std::allocator_arg, the_list_.get_allocator()};
+            }
+            else
+            {
+                return basic_py_vector{};
+            }
+        }
+
+        template<typename T, typename F>
+        void for_each_of_type(F&& func)
+        {
+            using good_type = mp11::mp_contains<new_types_set_<Ts...>, T>;
+            static_assert(std::is_same_v<good_type, mp11::mp_true>, "Type T must be in type signature of py_vector.");
+
+            for (auto& elem : the_list_)
+            {
+                mp11::mp_with_index<sizeof...(Ts)>(elem.index(), [&](auto I)
+                {
+                    if constexpr(std::is_same_v<T, std::variant_alternative_t<I, value_type>>)
+                    {
+                        func(*std::get_if<I>(&elem));
+                    }
+                });
+            }
+        }
+
+        // our elements are not contiguous so the reductions feed the numeric kernels
+        // blocks copied out of the list.
+
+        static constexpr std::size_t kernel_block_size = 256;
+
+        // the reductions want every numeric alternative so they are all gathered in the
+        // same pass over the list, each into a block of its own.
+
+        template<typename X>
+        struct kernel_block
+        {
+            X values[kernel_block_size];
+            std::size_t count{0};
+        };
+
+        template<typename F>
+        void for_each_numeric_block(F&& func) const
+        {
+            std::tuple<std::conditional_t<cpp_like_py::is_py_numeric_v<Ts>, kernel_block<Ts>, std::monostate>...> blocks;
+
+            for (const auto& elem : the_list_)
+            {
+                mp11::mp_with_index<sizeof...(Ts)>(elem.index(), [&](auto I)
+                {
+                    using X = std::variant_alternative_t<I, value_type>;
+                    if constexpr(cpp_like_py::is_py_numeric_v<X>)
+                    {
+                        auto& block = std::get<I>(blocks);
+                        block.values[block.count] = *std::get_if<I>(&elem);
+                        if (++block.count == kernel_block_size)
+                        {
+                            func(I, static_cast<const X*>(block.values), block.count);
+                            block.count = 0;
+                        }
+                    }
+                });
+            }
+            mp11::mp_for_each<mp11::mp_iota_c<sizeof...(Ts)>>([&](auto I)
+            {
+                using X = std::variant_alternative_t<I, value_type>;
+                if constexpr(cpp_like_py::is_py_numeric_v<X>)
+                {
+                    auto& block = std::get<I>(blocks);
+                    if (block.count != 0)
+                    {
+                        func(I, static_cast<const X*>(block.values), block.count);
+                    }
+                }
+            });
+        }
+
         /* ====================  DATA MEMBERS  ======================================= */
         pylist_t the_list_;
 
-}; /* ----------  end of template class py_vector  ---------- */
+        // how many elements hold each alternative.  Stale once someone has had a non-const
+        // reference to an element, until we count them again.
+
+        std::array<std::size_t, sizeof...(Ts)> type_counts_{};
+        bool counts_stale_ = false;
+
+}; /* ----------  end of template class basic_py_vector  ---------- */
 
 #endif   /* ----- #ifndef PY_VECTOR_INC  ----- */
@@ -0,0 +1,575 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  py_vector_io.h
+ *
+ *    Description:  binary save and load for py_vector, including loading
+ *                  straight from a memory mapped file.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 05:48:31 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  David P. Riedel (), driedel@cox.net
+ *   Organization:
+ *
+ * =====================================================================================
+ */
+
+
+#ifndef  _PY_VECTOR_IO_INC_
+#define  _PY_VECTOR_IO_INC_
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "py_vector.h"
+
+// The file format, version 1.  Numbers are written in the byte order of the machine
+// which wrote them.  The byte order mark lets a reader on a different machine refuse
+// the file rather than read garbage.
+//
+//  char[8]     "PYVECTOR"
+//  u16         version
+//  u16         byte order mark, 0x0102
+//  u16         number of distinct types in the list's type signature
+//  u16         reserved, 0
+//  per type:   u16 length of the type's name then the name
+//  u64         number of elements
+//  per element:
+//              tag     the type's position in the list above.  u8, or u16 if there
+//                      are more than 256 types.
+//              payload fixed size types: their bytes.
+//                      everything else: u64 length then that many bytes.
+
+namespace cpp_like_py
+{
+    // thrown for anything wrong with the contents of a file.  Problems with
+    // the file itself (can't open it, etc.) are std::system_error.
+
+    class py_vector_format_error : public std::runtime_error
+    {
+        public:
+
+            using std::runtime_error::runtime_error;
+    };
+
+    // reads what the writer wrote from a block of memory, checking we don't run off the end.
+
+    class byte_reader
+    {
+        public:
+
+            byte_reader(const char* first, const char* last) : pos_{first}, end_{last} { }
+
+            const char* take(std::size_t count)
+            {
+                if (static_cast<std::size_t>(end_ - pos_) < count)
+                {
+                    throw py_vector_format_error{"py_vector file is truncated."};
+                }
+                const char* result = pos_;
+                pos_ += count;
+                return result;
+            }
+
+            // copies, rather than casts, since nothing in the file is aligned.
+
+            template<typename T>
+            T read()
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                T value;
+                std::memcpy(&value, take(sizeof(T)), sizeof(T));
+                return value;
+            }
+
+            std::string_view read_sized()
+            {
+                const auto length = read<std::uint64_t>();
+                return std::string_view{take(length), length};
+            }
+
+            const char* position() const { return pos_; }
+
+        private:
+
+            const char* pos_;
+            const char* end_;
+    };
+
+    template<typename T>
+    void write_raw(std::ostream& out, const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    // how each alternative is written and read.  'name' goes in the file header so a
+    // reader can match the types in a file with its own.  'view_type' is what the
+    // zero copy reader hands out.  Specialize this for any other type you want to save.
+
+    template<typename T, typename = void>
+    struct serial_traits
+    {
+        static_assert(sizeof(T) == 0, "specialize cpp_like_py::serial_traits to save this type.");
+    };
+
+    template<typename T>
+    constexpr std::string_view arithmetic_name()
+    {
+        if constexpr(std::is_same_v<T, bool>) { return "bool"; }
+        else if constexpr(std::is_same_v<T, char>) { return "char"; }
+        else if constexpr(std::is_same_v<T, float>) { return "f32"; }
+        else if constexpr(std::is_same_v<T, double>) { return "f64"; }
+        else if constexpr(std::is_same_v<T, long double>) { return "long double"; }
+        else if constexpr(std::is_signed_v<T>)
+        {
+            if constexpr(sizeof(T) == 1) { return "i8"; }
+            else if constexpr(sizeof(T) == 2) { return "i16"; }
+            else if constexpr(sizeof(T) == 4) { return "i32"; }
+            else { return "i64"; }
+        }
+        else
+        {
+            if constexpr(sizeof(T) == 1) { return "u8"; }
+            else if constexpr(sizeof(T) == 2) { return "u16"; }
+            else if constexpr(sizeof(T) == 4) { return "u32"; }
+            else { return "u64"; }
+        }
+    }
+
+    template<typename T>
+    struct serial_traits<T, std::enable_if_t<std::is_arithmetic_v<T>>>
+    {
+        static constexpr std::string_view name = arithmetic_name<T>();
+        using view_type = T;
+
+        static void write(std::ostream& out, const T& value) { write_raw(out, value); }
+        static T read(byte_reader& in) { return in.read<T>(); }
+        static view_type view(byte_reader& in) { return in.read<T>(); }
+    };
+
+    template<>
+    struct serial_traits<std::string>
+    {
+        static constexpr std::string_view name = "str";
+        using view_type = std::string_view;
+
+        static void write(std::ostream& out, const std::string& value)
+        {
+            write_raw(out, static_cast<std::uint64_t>(value.size()));
+            out.write(value.data(), static_cast<std::streamsize>(value.size()));
+        }
+        static std::string read(byte_reader& in) { return std::string{in.read_sized()}; }
+        static view_type view(byte_reader& in) { return in.read_sized(); }
+    };
+
+    inline constexpr char py_vector_magic[8] = {'P', 'Y', 'V', 'E', 'C', 'T', 'O', 'R'};
+    inline constexpr std::uint16_t py_vector_format_version = 1;
+    inline constexpr std::uint16_t py_vector_byte_order_mark = 0x0102;
+
+    /* ====================  WRITING     ======================================= */
+
+    // writes one element at a time so 'out' can be anything, including a pipe.
+
+    template<typename S, typename ...Ts>
+    void write_py_vector(std::ostream& out, const basic_py_vector<S, Ts...>& list)
+    {
+        using file_types = new_types_set_<Ts...>;
+        constexpr std::size_t type_count = mp11::mp_size<file_types>::value;
+        using tag_t = type_tag_t<type_count>;
+
+        // the tag for each of our alternatives.  Duplicate types share a tag.
+
+        using to_file = alternative_translation<file_types, mp11::mp_list<Ts...>>;
+
+        out.write(py_vector_magic, sizeof(py_vector_magic));
+        write_raw(out, py_vector_format_version);
+        write_raw(out, py_vector_byte_order_mark);
+        write_raw(out, static_cast<std::uint16_t>(type_count));
+        write_raw(out, std::uint16_t{0});
+
+        mp11::mp_for_each<mp11::mp_transform<mp11::mp_identity, file_types>>([&out](auto type)
+        {
+            constexpr std::string_view name = serial_traits<typename decltype(type)::type>::name;
+            write_raw(out, static_cast<std::uint16_t>(name.size()));
+            out.write(name.data(), name.size());
+        });
+
+        write_raw(out, static_cast<std::uint64_t>(list.size()));
+
+        for (const auto& elem : list)
+        {
+            mp11::mp_with_index<sizeof...(Ts)>(elem.index(), [&](auto I)
+            {
+                using X = std::variant_alternative_t<I, std::variant<Ts...>>;
+                write_raw(out, static_cast<tag_t>(to_file::value[I]));
+                serial_traits<X>::write(out, *std::get_if<I>(&elem));
+            });
+        }
+    }
+
+    template<typename S, typename ...Ts>
+    void save_py_vector(const std::string& file_name, const basic_py_vector<S, Ts...>& list)
+    {
+        std::ofstream out{file_name, std::ios::out | std::ios::binary | std::ios::trunc};
+        if (! out)
+        {
+            throw std::system_error{errno, std::generic_category(), "can't create: " + file_name};
+        }
+        write_py_vector(out, list);
+        out.flush();
+        if (! out)
+        {
+            throw std::system_error{errno, std::generic_category(), "error writing: " + file_name};
+        }
+    }
+
+    /* ====================  READING     ======================================= */
+
+    // what we learn from a file's header: which of our alternatives takes each of the
+    // file's types, how big its tags are and where the elements start.
+
+    struct py_vector_file_layout
+    {
+        std::vector<std::size_t> to_ours;
+        std::size_t tag_size;
+        std::uint64_t count;
+        const char* elements;
+    };
+
+    // a file can be read into any list which can hold every type in the file.  That is
+    // the same rule as the converting constructor but checked when we read the file.
+
+    template<typename ...Ts>
+    py_vector_file_layout read_py_vector_header(mp11::mp_list<Ts...>, byte_reader& in)
+    {
+        if (std::memcmp(in.take(sizeof(py_vector_magic)), py_vector_magic, sizeof(py_vector_magic)) != 0)
+        {
+            throw py_vector_format_error{"not a py_vector file."};
+        }
+        if (const auto version = in.read<std::uint16_t>(); version != py_vector_format_version)
+        {
+            throw py_vector_format_error{"unsupported py_vector file version: " + std::to_string(version)};
+        }
+        if (in.read<std::uint16_t>() != py_vector_byte_order_mark)
+        {
+            throw py_vector_format_error{"py_vector file was written on a machine with a different byte order."};
+        }
+
+        const auto type_count = in.read<std::uint16_t>();
+        in.read<std::uint16_t>();
+
+        constexpr std::array<std::string_view, sizeof...(Ts)> our_names{ {serial_traits<Ts>::name ...} };
+
+        py_vector_file_layout result;
+        result.to_ours.reserve(type_count);
+        for (std::size_t i = 0; i < type_count; ++i)
+        {
+            const auto name_size = in.read<std::uint16_t>();
+            const std::string_view name{in.take(name_size), name_size};
+
+            // duplicate types go to our first alternative of that type, same as everywhere else.
+
+            auto ours = std::find(our_names.begin(), our_names.end(), name);
+            if (ours == our_names.end())
+            {
+                throw py_vector_format_error{"py_vector file holds type '" + std::string{name}
+                    + "' which is not in our type signature."};
+            }
+            result.to_ours.push_back(ours - our_names.begin());
+        }
+
+        result.tag_size = type_count <= 256 ? 1 : 2;
+        result.count = in.read<std::uint64_t>();
+        result.elements = in.position();
+        return result;
+    }
+
+    inline std::size_t read_tag(byte_reader& in, const py_vector_file_layout& layout)
+    {
+        const std::size_t tag = layout.tag_size == 1 ? in.read<std::uint8_t>() : in.read<std::uint16_t>();
+        if (tag >= layout.to_ours.size())
+        {
+            throw py_vector_format_error{"bad element tag in py_vector file."};
+        }
+        return tag;
+    }
+
+    // builds a List (any basic_py_vector) from a block of memory holding a file's contents.
+    // Makes one pass and reserves the whole list up front.
+
+    template<typename List>
+    List load_py_vector(const char* data, std::size_t size)
+    {
+        using value_type = typename List::value_type;
+        constexpr std::size_t our_count = std::variant_size_v<value_type>;
+
+        byte_reader in{data, data + size};
+        const auto layout = read_py_vector_header(mp11::mp_rename<value_type, mp11::mp_list>{}, in);
+
+        List result;
+
+        // every element takes at least a tag so a huge count in a short file is corrupt.
+
+        if (layout.count > size / layout.tag_size)
+        {
+            throw py_vector_format_error{"py_vector file is truncated."};
+        }
+        result.reserve(layout.count);
+
+        for (std::uint64_t i = 0; i < layout.count; ++i)
+        {
+            mp11::mp_with_index<our_count>(layout.to_ours[read_tag(in, layout)], [&](auto I)
+            {
+                using X = std::variant_alternative_t<I, value_type>;
+                result.append(serial_traits<X>::read(in));
+            });
+        }
+        return result;
+    }
+
+    template<typename List>
+    List read_py_vector(std::istream& in)
+    {
+        const std::string contents{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+        return load_py_vector<List>(contents.data(), contents.size());
+    }
+
+    /*
+     * =====================================================================================
+     *        Class:  mapped_file
+     *  Description:  a whole file mapped read only into memory.
+     * =====================================================================================
+     */
+
+    class mapped_file
+    {
+        public:
+
+            /* ====================  LIFECYCLE     ======================================= */
+            explicit mapped_file (const std::string& file_name)                  /* constructor */
+            {
+                const int fd = ::open(file_name.c_str(), O_RDONLY);
+                if (fd < 0)
+                {
+                    throw std::system_error{errno, std::generic_category(), "can't open: " + file_name};
+                }
+
+                struct stat info;
+                if (::fstat(fd, &info) != 0)
+                {
+                    const int error = errno;
+                    ::close(fd);
+                    throw std::system_error{error, std::generic_category(), "can't stat: " + file_name};
+                }
+                size_ = static_cast<std::size_t>(info.st_size);
+
+                if (size_ != 0)
+                {
+                    void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (data == MAP_FAILED)
+                    {
+                        const int error = errno;
+                        ::close(fd);
+                        throw std::system_error{error, std::generic_category(), "can't map: " + file_name};
+                    }
+                    data_ = static_cast<const char*>(data);
+
+                    // we read front to back so let the kernel read ahead.
+
+                    ::madvise(data, size_, MADV_SEQUENTIAL);
+                }
+
+                // the mapping stays good after the file is closed.
+
+                ::close(fd);
+            }
+
+            ~mapped_file ()
+            {
+                if (data_ != nullptr)
+                {
+                    ::munmap(const_cast<char*>(data_), size_);
+                }
+            }
+
+            mapped_file (const mapped_file&) = delete;
+            mapped_file& operator=(const mapped_file&) = delete;
+
+            mapped_file (mapped_file&& rhs) noexcept : data_{rhs.data_}, size_{rhs.size_}
+            {
+                rhs.data_ = nullptr;
+                rhs.size_ = 0;
+            }
+
+            mapped_file& operator=(mapped_file&& rhs) noexcept
+            {
+                std::swap(data_, rhs.data_);
+                std::swap(size_, rhs.size_);
+                return *this;
+            }
+
+            /* ====================  ACCESSORS     ======================================= */
+
+            const char* data() const { return data_; }
+            std::size_t size() const { return size_; }
+
+        private:
+
+            /* ====================  DATA MEMBERS  ======================================= */
+
+            const char* data_ = nullptr;
+            std::size_t size_ = 0;
+
+    }; /* ----------  end of class mapped_file  ---------- */
+
+    template<typename List>
+    List load_py_vector(const std::string& file_name)
+    {
+        const mapped_file file{file_name};
+        return load_py_vector<List>(file.data(), file.size());
+    }
+}		/* -----  end of namespace cpp_like_py  ----- */
+
+/*
+ * =====================================================================================
+ *        Class:  py_vector_file_view
+ *  Description:  read only, zero copy look at a saved py_vector.
+ * =====================================================================================
+ */
+
+// Maps the file and hands out its elements as they are found there.  Strings come
+// back as std::string_views into the mapping so nothing is copied.  The elements are
+// different lengths so we can only go front to back.
+
+template<typename ...Ts>
+class py_vector_file_view
+{
+    public:
+
+        using value_type = std::variant<typename cpp_like_py::serial_traits<Ts>::view_type...>;
+
+        class const_iterator
+        {
+            public:
+
+                using iterator_category = std::input_iterator_tag;
+                using value_type = py_vector_file_view::value_type;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const value_type*;
+                using reference = const value_type&;
+
+                const_iterator(const cpp_like_py::py_vector_file_layout* layout, const char* first, const char* last, std::uint64_t pos)
+                    : layout_{layout}, in_{first, last}, pos_{pos}
+                {
+                    read_current();
+                }
+
+                reference operator*() const { return current_; }
+                pointer operator->() const { return &current_; }
+
+                const_iterator& operator++()
+                {
+                    ++pos_;
+                    read_current();
+                    return *this;
+                }
+
+                bool operator==(const const_iterator& rhs) const { return pos_ == rhs.pos_; }
+                bool operator!=(const const_iterator& rhs) const { return pos_ != rhs.pos_; }
+
+            private:
+
+                void read_current()
+                {
+                    if (pos_ < layout_->count)
+                    {
+                        mp11::mp_with_index<sizeof...(Ts)>(layout_->to_ours[cpp_like_py::read_tag(in_, *layout_)], [&](auto I)
+                        {
+                            using X = mp11::mp_at_c<mp11::mp_list<Ts...>, I>;
+                            current_.template emplace<I>(cpp_like_py::serial_traits<X>::view(in_));
+                        });
+                    }
+                }
+
+                const cpp_like_py::py_vector_file_layout* layout_;
+                cpp_like_py::byte_reader in_;
+                std::uint64_t pos_;
+                value_type current_;
+        };
+
+        /* ====================  LIFECYCLE     ======================================= */
+        explicit py_vector_file_view (const std::string& file_name)        /* constructor */
+            : file_{file_name}
+        {
+            cpp_like_py::byte_reader in{file_.data(), file_.data() + file_.size()};
+            layout_ = cpp_like_py::read_py_vector_header(mp11::mp_list<Ts...>{}, in);
+        }
+
+        py_vector_file_view (const py_vector_file_view&) = delete;
+        py_vector_file_view& operator=(const py_vector_file_view&) = delete;
+
+        /* ====================  ACCESSORS     ======================================= */
+
+        std::size_t size() const { return layout_.count; }
+        bool empty() const { return layout_.count == 0; }
+
+        const_iterator begin() const { return const_iterator{&layout_, layout_.elements, end_of_file(), 0}; }
+        const_iterator end() const { return const_iterator{&layout_, end_of_file(), end_of_file(), layout_.count}; }
+
+        void print_list(std::ostream& out, const cpp_like_py::format_options& options = {}) const
+        {
+            cpp_like_py::print_elements(out, begin(), end(), options);
+        }
+
+        // applies func to each element of type T, as its view_type.
+
+        template<typename T, class F>
+        void visit_all(F&& func) const
+        {
+            for (const auto& elem : *this)
+            {
+                mp11::mp_with_index<sizeof...(Ts)>(elem.index(), [&](auto I)
+                {
+                    if constexpr (std::is_same_v<T, mp11::mp_at_c<mp11::mp_list<Ts...>, I>>)
+                    {
+                        func(*std::get_if<I>(&elem));
+                    }
+                });
+            }
+        }
+
+        // copy the whole file into a list.
+
+        py_vector<Ts...> to_py_vector() const
+        {
+            return cpp_like_py::load_py_vector<py_vector<Ts...>>(file_.data(), file_.size());
+        }
+
+    private:
+
+        const char* end_of_file() const { return file_.data() + file_.size(); }
+
+        /* ====================  DATA MEMBERS  ======================================= */
+
+        cpp_like_py::mapped_file file_;
+        cpp_like_py::py_vector_file_layout layout_;
+
+}; /* ----------  end of template class py_vector_file_view  ---------- */
+
+#endif   /* ----- #ifndef _PY_VECTOR_IO_INC_  ----- */
@@ -0,0 +1,451 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  py_vector_stats.h
+ *
+ *    Description:  optional usage statistics for py_vector.  Build with
+ *                  -DPY_VECTOR_STATS to turn them on.  Otherwise everything here
+ *                  compiles away to nothing.
+ *
+ *        Version:  1.0
+ *        Created:  10/18/2026 12:14:55 AM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  David P. Riedel (), driedel@cox.net
+ *   Organization:
+ *
+ * =====================================================================================
+ */
+
+
+#ifndef  _PY_VECTOR_STATS_INC_
+#define  _PY_VECTOR_STATS_INC_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#include <boost/core/demangle.hpp>
+
+namespace cpp_like_py
+{
+#if defined(PY_VECTOR_STATS)
+    inline constexpr bool stats_enabled = true;
+#else
+    inline constexpr bool stats_enabled = false;
+#endif
+
+    // what one list has been up to.  Per alternative counts are in type signature order.
+
+    template<std::size_t N>
+    struct list_counters
+    {
+        std::uint64_t allocations = 0;              // first time the list got storage
+        std::uint64_t reallocations = 0;            // grew and had to move its elements
+        std::uint64_t bytes_copied = 0;             // by copies and reallocations
+        std::uint64_t contains_calls = 0;           // contains, index_of and count
+        std::uint64_t elements_scanned = 0;         // ... and how many elements they looked at
+        std::array<std::uint64_t, N> visits{};      // visit_all calls
+    };
+
+    // totals for every list with the same type signature, whatever their storage.
+
+    struct signature_stats
+    {
+        std::string signature;
+        std::vector<std::string> types;
+        std::uint64_t lists_created = 0;
+        std::uint64_t live_lists = 0;
+        std::uint64_t allocations = 0;
+        std::uint64_t reallocations = 0;
+        std::uint64_t bytes_copied = 0;
+        std::uint64_t contains_calls = 0;
+        std::uint64_t elements_scanned = 0;
+        std::vector<std::uint64_t> visits;
+        std::vector<std::uint64_t> live_elements;   // in the live lists, by alternative
+    };
+
+    // each live list is linked into its signature's record so a report can count
+    // what's in them right now.
+
+    struct live_list_link
+    {
+        live_list_link* prev = nullptr;
+        live_list_link* next = nullptr;
+        void (*count_alternatives)(const live_list_link*, std::uint64_t*) = nullptr;
+    };
+
+    struct signature_record
+    {
+        signature_record(std::string name, std::vector<std::string> type_names)
+            : signature{std::move(name)}, types{std::move(type_names)},
+            visits{new std::atomic<std::uint64_t>[types.size()]()}
+        {
+        }
+
+        const std::string signature;
+        const std::vector<std::string> types;
+
+        std::atomic<std::uint64_t> lists_created{0};
+        std::atomic<std::uint64_t> allocations{0};
+        std::atomic<std::uint64_t> reallocations{0};
+        std::atomic<std::uint64_t> bytes_copied{0};
+        std::atomic<std::uint64_t> contains_calls{0};
+        std::atomic<std::uint64_t> elements_scanned{0};
+        std::unique_ptr<std::atomic<std::uint64_t>[]> visits;
+
+        std::mutex live_mutex;
+        live_list_link* live_lists = nullptr;
+    };
+
+    /*
+     * =====================================================================================
+     *        Class:  stats_registry
+     *  Description:  the totals for every type signature seen so far.
+     * =====================================================================================
+     */
+
+    class stats_registry
+    {
+        public:
+
+            // never destroyed so lists with static storage duration can still
+            // unlink themselves on the way out.
+
+            static stats_registry& instance()
+            {
+                static stats_registry* registry = new stats_registry;
+                return *registry;
+            }
+
+            // the record for a type signature.  Made the first time it's asked for.
+
+            template<typename ...Ts>
+            static signature_record& record()
+            {
+                static signature_record& result = instance().add_record(
+                        "py_vector<" + join({type_name<Ts>()...}) + ">", {type_name<Ts>()...});
+                return result;
+            }
+
+            template<typename ...Ts>
+            static const std::string& signature_name()
+            {
+                return record<Ts...>().signature;
+            }
+
+            // live_elements walks every live list so don't call this while other threads
+            // are changing lists.
+
+            std::vector<signature_stats> snapshot() const
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+
+                std::vector<signature_stats> result;
+                result.reserve(records_.size());
+                for (const auto& r : records_)
+                {
+                    const auto n = r->types.size();
+                    signature_stats s{r->signature, r->types, r->lists_created, 0, r->allocations, r->reallocations,
+                        r->bytes_copied, r->contains_calls, r->elements_scanned, std::vector<std::uint64_t>(n),
+                        std::vector<std::uint64_t>(n)};
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        s.visits[i] = r->visits[i];
+                    }
+
+                    std::lock_guard<std::mutex> live_lock{r->live_mutex};
+                    for (auto* link = r->live_lists; link != nullptr; link = link->next)
+                    {
+                        ++s.live_lists;
+                        link->count_alternatives(link, s.live_elements.data());
+                    }
+                    result.push_back(std::move(s));
+                }
+                return result;
+            }
+
+            void report(std::ostream& out) const
+            {
+                if constexpr(! stats_enabled)
+                {
+                    out << "py_vector statistics are off.  Build with -DPY_VECTOR_STATS to collect them.\n";
+                }
+
+                for (const auto& s : snapshot())
+                {
+                    out << s.signature << '\n'
+                        << "    lists: " << s.lists_created << " created, " << s.live_lists << " live\n"
+                        << "    allocations: " << s.allocations << "  reallocations: " << s.reallocations
+                        << "  bytes copied: " << s.bytes_copied << '\n'
+                        << "    contains calls: " << s.contains_calls << "  elements scanned: " << s.elements_scanned << '\n'
+                        << "    visit_all calls:";
+                    for (std::size_t i = 0; i < s.types.size(); ++i)
+                    {
+                        out << "  " << s.types[i] << ": " << s.visits[i];
+                    }
+                    out << "\n    live elements:";
+                    for (std::size_t i = 0; i < s.types.size(); ++i)
+                    {
+                        out << "  " << s.types[i] << ": " << s.live_elements[i];
+                    }
+                    out << '\n';
+                }
+            }
+
+        private:
+
+            stats_registry() = default;
+
+            // std::string's full name is too long to read in a report.
+
+            template<typename T>
+            static std::string type_name()
+            {
+                if constexpr(std::is_same_v<T, std::string>)
+                {
+                    return "std::string";
+                }
+                else
+                {
+                    return boost::core::demangle(typeid(T).name());
+                }
+            }
+
+            static std::string join(std::initializer_list<std::string> names)
+            {
+                std::string result;
+                for (const auto& name : names)
+                {
+                    if (! result.empty())
+                    {
+                        result += ", ";
+                    }
+                    result += name;
+                }
+                return result;
+            }
+
+            signature_record& add_record(std::string name, std::vector<std::string> type_names)
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+                records_.push_back(std::make_unique<signature_record>(std::move(name), std::move(type_names)));
+                return *records_.back();
+            }
+
+            mutable std::mutex mutex_;
+            std::vector<std::unique_ptr<signature_record>> records_;
+    };
+
+    /*
+     * =====================================================================================
+     *        Class:  list_stats
+     *  Description:  base class of basic_py_vector which keeps its counters.  'List' is
+     *                the derived list class.
+     * =====================================================================================
+     */
+
+#if defined(PY_VECTOR_STATS)
+
+    template<typename List, typename ...Ts>
+    class list_stats : private live_list_link
+    {
+        public:
+
+            // a snapshot.  The counters are atomic so lists can still be read from many
+            // threads at once.
+
+            list_counters<sizeof...(Ts)> stats() const
+            {
+                list_counters<sizeof...(Ts)> result;
+                result.allocations = counters_.allocations.load(std::memory_order_relaxed);
+                result.reallocations = counters_.reallocations.load(std::memory_order_relaxed);
+                result.bytes_copied = counters_.bytes_copied.load(std::memory_order_relaxed);
+                result.contains_calls = counters_.contains_calls.load(std::memory_order_relaxed);
+                result.elements_scanned = counters_.elements_scanned.load(std::memory_order_relaxed);
+                for (std::size_t i = 0; i < sizeof...(Ts); ++i)
+                {
+                    result.visits[i] = counters_.visits[i].load(std::memory_order_relaxed);
+                }
+                return result;
+            }
+
+        protected:
+
+            // watches a container for growth during one operation.
+
+            template<typename Container>
+            class growth_watch
+            {
+                public:
+
+                    growth_watch(const list_stats& owner, const Container& list)
+                        : owner_{owner}, list_{list}, capacity_{list.capacity()}, size_{list.size()} { }
+
+                    ~growth_watch()
+                    {
+                        if (list_.capacity() > capacity_)
+                        {
+                            owner_.note_growth(capacity_, size_ * sizeof(typename Container::value_type));
+                        }
+                    }
+
+                private:
+
+                    const list_stats& owner_;
+                    const Container& list_;
+                    std::size_t capacity_;
+                    std::size_t size_;
+            };
+
+            list_stats()
+            {
+                link();
+            }
+
+            // a copy is a new list with counters of its own.
+
+            list_stats(const list_stats&) : list_stats() { }
+            list_stats& operator=(const list_stats&) { return *this; }
+
+            ~list_stats()
+            {
+                std::lock_guard<std::mutex> lock{record_.live_mutex};
+                (prev != nullptr ? prev->next : record_.live_lists) = next;
+                if (next != nullptr)
+                {
+                    next->prev = prev;
+                }
+            }
+
+            template<typename Container>
+            growth_watch<Container> watch_growth(const Container& list) const
+            {
+                return {*this, list};
+            }
+
+            // a new list which was filled by copying.
+
+            template<typename Container>
+            void note_filled(const Container& list) const
+            {
+                if (list.capacity() != 0)
+                {
+                    counters_.allocations.fetch_add(1, std::memory_order_relaxed);
+                    record_.allocations.fetch_add(1, std::memory_order_relaxed);
+                }
+                note_copied(list.size(), sizeof(typename Container::value_type));
+            }
+
+            void note_copied(std::size_t count, std::size_t element_size) const
+            {
+                counters_.bytes_copied.fetch_add(count * element_size, std::memory_order_relaxed);
+                record_.bytes_copied.fetch_add(count * element_size, std::memory_order_relaxed);
+            }
+
+            void note_scan(std::size_t scanned) const
+            {
+                counters_.contains_calls.fetch_add(1, std::memory_order_relaxed);
+                counters_.elements_scanned.fetch_add(scanned, std::memory_order_relaxed);
+                record_.contains_calls.fetch_add(1, std::memory_order_relaxed);
+                record_.elements_scanned.fetch_add(scanned, std::memory_order_relaxed);
+            }
+
+            void note_visit(std::size_t alternative) const
+            {
+                counters_.visits[alternative].fetch_add(1, std::memory_order_relaxed);
+                record_.visits[alternative].fetch_add(1, std::memory_order_relaxed);
+            }
+
+        private:
+
+            void link()
+            {
+                count_alternatives = [](const live_list_link* link, std::uint64_t* counts)
+                {
+                    const auto& list = static_cast<const List&>(static_cast<const list_stats&>(*link));
+                    for (const auto& elem : list)
+                    {
+                        ++counts[elem.index()];
+                    }
+                };
+                record_.lists_created.fetch_add(1, std::memory_order_relaxed);
+
+                std::lock_guard<std::mutex> lock{record_.live_mutex};
+                next = record_.live_lists;
+                if (next != nullptr)
+                {
+                    next->prev = this;
+                }
+                record_.live_lists = this;
+            }
+
+            void note_growth(std::size_t old_capacity, std::size_t moved_bytes) const
+            {
+                if (old_capacity == 0)
+                {
+                    counters_.allocations.fetch_add(1, std::memory_order_relaxed);
+                    record_.allocations.fetch_add(1, std::memory_order_relaxed);
+                }
+                else
+                {
+                    counters_.reallocations.fetch_add(1, std::memory_order_relaxed);
+                    record_.reallocations.fetch_add(1, std::memory_order_relaxed);
+                    note_copied(moved_bytes, 1);
+                }
+            }
+
+            struct atomic_counters
+            {
+                std::atomic<std::uint64_t> allocations{0};
+                std::atomic<std::uint64_t> reallocations{0};
+                std::atomic<std::uint64_t> bytes_copied{0};
+                std::atomic<std::uint64_t> contains_calls{0};
+                std::atomic<std::uint64_t> elements_scanned{0};
+                std::array<std::atomic<std::uint64_t>, sizeof...(Ts)> visits{};
+            };
+
+            signature_record& record_ = stats_registry::record<Ts...>();
+            mutable atomic_counters counters_;
+    };
+
+#else
+
+    // statistics off: no data and the hooks do nothing.
+
+    template<typename List, typename ...Ts>
+    class list_stats
+    {
+        public:
+
+            list_counters<sizeof...(Ts)> stats() const { return {}; }
+
+        protected:
+
+            struct growth_watch { };
+
+            template<typename Container>
+            growth_watch watch_growth(const Container&) const { return {}; }
+
+            template<typename Container>
+            void note_filled(const Container&) const { }
+
+            void note_copied(std::size_t, std::size_t) const { }
+            void note_scan(std::size_t) const { }
+            void note_visit(std::size_t) const { }
+    };
+
+#endif
+
+}		/* -----  end of namespace cpp_like_py  ----- */
+
+#endif   /* ----- #ifndef _PY_VECTOR_STATS_INC_  ----- */
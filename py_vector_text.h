@@ -0,0 +1,791 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  py_vector_text.h
+ *
+ *    Description:  builds py_vectors from CSV and JSON lines text, choosing each
+ *                  field's type from what it looks like.
+ *
+ *        Version:  1.0
+ *        Created:  10/18/2026 03:12:47 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  David P. Riedel (), driedel@cox.net
+ *   Organization:
+ *
+ * =====================================================================================
+ */
+
+
+#ifndef  _PY_VECTOR_TEXT_INC_
+#define  _PY_VECTOR_TEXT_INC_
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "py_vector_io.h"
+
+// Each field becomes the narrowest alternative in the list's type signature which
+// holds it exactly:
+//
+//  quoted         std::string, or char if there's no std::string and it is 1 character.
+//                 A quoted CSV field is text even if it looks like a number, "01234" say.
+//  integer        the smallest integral type, not counting bool and char, it fits in.
+//                 If none of them will do it is a floating point number.
+//  floating       float if float gives back exactly the same double, else double, etc.
+//                 If none is exact, the widest floating type whose range it is in.
+//  true/false     bool, also True/False like Python writes them.
+//  null           std::monostate.  An empty unquoted CSV field is an empty std::string
+//                 if there is one, else std::monostate.
+//  anything else  char if it is 1 character, else std::string.
+//
+// A field none of the list's types can hold is a py_vector_format_error naming its record.
+
+namespace cpp_like_py
+{
+    enum class text_format { csv, json_lines };
+
+    struct text_options
+    {
+        text_format format = text_format::csv;
+        char delimiter = ',';                   // CSV only
+        bool has_header = false;                // CSV only.  The first record is skipped.
+        std::size_t block_size = 1 << 20;       // how much for_each_text_row reads at a time
+    };
+
+    enum class field_kind { bare, quoted, null };
+
+    // one field as it appears in the text.  'text' points into the input, or for a
+    // field with escapes in it, into the parser's scratch buffer, so it is only good
+    // until the next field.
+
+    struct text_field
+    {
+        std::string_view text;
+        field_kind kind = field_kind::bare;
+    };
+
+    /* ====================  TYPE INFERENCE  ======================================= */
+
+    template<typename T>
+        using is_inferred_integer = mp11::mp_bool<std::is_integral_v<T> && ! std::is_same_v<T, bool> && ! is_char_v<T>>;
+
+    template<typename A, typename B>
+        using is_narrower = mp11::mp_bool<(sizeof(A) < sizeof(B))>;
+
+    template<typename L, template<typename> class P>
+        using narrowest_first = mp11::mp_sort<mp11::mp_unique<mp11::mp_copy_if<L, P>>, is_narrower>;
+
+    // from_chars also reads nan, inf and infinity as doubles.  We only want numbers which
+    // look like numbers: an optional '-' then a digit or a '.' and a digit.
+
+    inline bool looks_numeric(const char* first, const char* last)
+    {
+        if (first != last && *first == '-')
+        {
+            ++first;
+        }
+        if (first != last && *first == '.')
+        {
+            ++first;
+        }
+        return first != last && *first >= '0' && *first <= '9';
+    }
+
+    // stores 'field' as the narrowest of List's alternatives which can hold it.  Returns
+    // false if none of them can.
+
+    template<typename List>
+    bool append_inferred(List& list, const text_field& field)
+    {
+        using types = mp11::mp_rename<typename List::value_type, mp11::mp_list>;
+        constexpr bool has_string = mp11::mp_contains<types, std::string>::value;
+        constexpr bool has_char = mp11::mp_contains<types, char>::value;
+        constexpr bool has_bool = mp11::mp_contains<types, bool>::value;
+        constexpr bool has_none = mp11::mp_contains<types, std::monostate>::value;
+
+        const std::string_view text = field.text;
+
+        auto as_text = [&list, text]()
+        {
+            if constexpr(has_char)
+            {
+                if (text.size() == 1)
+                {
+                    list.template emplace<char>(text[0]);
+                    return true;
+                }
+            }
+            if constexpr(has_string)
+            {
+                list.template emplace<std::string>(text);
+                return true;
+            }
+            return false;
+        };
+
+        if (field.kind == field_kind::null)
+        {
+            if constexpr(has_none)
+            {
+                list.template emplace<std::monostate>();
+                return true;
+            }
+            return false;
+        }
+        if (field.kind == field_kind::quoted)
+        {
+            if constexpr(has_string)
+            {
+                list.template emplace<std::string>(text);
+                return true;
+            }
+            return as_text();
+        }
+        if (text.empty())
+        {
+            if constexpr(has_string)
+            {
+                list.template emplace<std::string>();
+                return true;
+            }
+            else if constexpr(has_none)
+            {
+                list.template emplace<std::monostate>();
+                return true;
+            }
+            return false;
+        }
+
+        // from_chars doesn't take a leading '+'.
+
+        const char* first = text.data();
+        const char* const last = text.data() + text.size();
+        if (*first == '+' && text.size() > 1 && *(first + 1) != '-')
+        {
+            ++first;
+        }
+
+        bool stored{false};
+        mp11::mp_for_each<mp11::mp_transform<mp11::mp_identity, narrowest_first<types, is_inferred_integer>>>([&](auto type)
+        {
+            using X = typename decltype(type)::type;
+            X value;
+            if (! stored)
+            {
+                const auto [ptr, ec] = std::from_chars(first, last, value);
+                if (ec == std::errc{} && ptr == last)
+                {
+                    list.template emplace<X>(value);
+                    stored = true;
+                }
+            }
+        });
+        if (stored)
+        {
+            return true;
+        }
+
+        using floats = narrowest_first<types, std::is_floating_point>;
+        if constexpr(mp11::mp_size<floats>::value != 0)
+        {
+            double value;
+            const auto [ptr, ec] = std::from_chars(first, last, value);
+            if (ec == std::errc{} && ptr == last && looks_numeric(first, last))
+            {
+                // a float can only hold what is in its range.  Converting anything else
+                // is undefined.
+
+                auto fits([value](auto type)
+                {
+                    using X = typename decltype(type)::type;
+                    return sizeof(X) >= sizeof(double) || ! std::isfinite(value)
+                        || std::abs(value) <= static_cast<double>(std::numeric_limits<X>::max());
+                });
+                auto store([&](auto type)
+                {
+                    using X = typename decltype(type)::type;
+                    if constexpr(std::is_same_v<X, long double>)
+                    {
+                        long double wide;
+                        std::from_chars(first, last, wide);
+                        list.template emplace<X>(wide);
+                    }
+                    else
+                    {
+                        list.template emplace<X>(static_cast<X>(value));
+                    }
+                    stored = true;
+                });
+
+                mp11::mp_for_each<mp11::mp_transform<mp11::mp_identity, floats>>([&](auto type)
+                {
+                    using X = typename decltype(type)::type;
+                    if (! stored && fits(type) && (sizeof(X) >= sizeof(double) || static_cast<double>(static_cast<X>(value)) == value))
+                    {
+                        store(type);
+                    }
+                });
+
+                // none of them holds it exactly, 0.1 with only float say.  The widest
+                // is as close as we can get.
+
+                if (! stored && fits(mp11::mp_identity<mp11::mp_back<floats>>{}))
+                {
+                    store(mp11::mp_identity<mp11::mp_back<floats>>{});
+                }
+                if (stored)
+                {
+                    return true;
+                }
+            }
+        }
+
+        if constexpr(has_bool)
+        {
+            if (text == "true" || text == "True")
+            {
+                list.template emplace<bool>(true);
+                return true;
+            }
+            if (text == "false" || text == "False")
+            {
+                list.template emplace<bool>(false);
+                return true;
+            }
+        }
+        return as_text();
+    }
+
+    /*
+     * =====================================================================================
+     *        Class:  text_record_parser
+     *  Description:  splits a block of CSV or JSON lines text into records and fields.
+     * =====================================================================================
+     */
+
+    // Fields are handed out as views into the block.  Only fields with escapes in them
+    // are copied, into one scratch buffer which is reused, so there is no allocation per
+    // field.  Blank lines are skipped.
+    //
+    // A JSON line is an array of scalars, an object whose values are scalars (the keys
+    // are dropped) or one scalar.
+
+    class text_record_parser
+    {
+        public:
+
+            /* ====================  LIFECYCLE     ======================================= */
+            explicit text_record_parser (const text_options& options)         /* constructor */
+                : options_{options}, skip_next_{options.format == text_format::csv && options.has_header} { }
+
+            /* ====================  ACCESSORS     ======================================= */
+
+            // how many records we've seen, counting a header.
+
+            std::size_t records() const { return records_; }
+
+            /* ====================  MUTATORS      ======================================= */
+
+            // calls on_field(const text_field&) for each field of each complete record in
+            // [first, last) and on_record() after each record.  Returns where the first
+            // record which isn't all there starts, which is 'last' if 'at_eof'.  Stops
+            // early, returning where it stopped, if on_record() returns false.
+
+            template<typename OnField, typename OnRecord>
+            const char* parse(const char* first, const char* last, bool at_eof, OnField&& on_field, OnRecord&& on_record)
+            {
+                while (first != last)
+                {
+                    const char* end = find_record_end(first, last);
+                    if (end == nullptr)
+                    {
+                        if (! at_eof)
+                        {
+                            return first;
+                        }
+                        end = last;
+                    }
+                    const char* next = end == last ? last : end + 1;
+                    if (end != first && *(end - 1) == '\r')
+                    {
+                        --end;
+                    }
+
+                    if (is_blank(first, end))
+                    {
+                        first = next;
+                        continue;
+                    }
+                    ++records_;
+                    if (skip_next_)
+                    {
+                        skip_next_ = false;
+                        first = next;
+                        continue;
+                    }
+
+                    if (options_.format == text_format::csv)
+                    {
+                        parse_csv(first, end, on_field);
+                    }
+                    else
+                    {
+                        parse_json(first, end, on_field);
+                    }
+                    first = next;
+                    if (! on_record())
+                    {
+                        break;
+                    }
+                }
+                return first;
+            }
+
+            [[noreturn]] void fail(const std::string& what) const
+            {
+                throw py_vector_format_error{"record " + std::to_string(records_) + ": " + what};
+            }
+
+        private:
+
+            /* ====================  METHODS       ======================================= */
+
+            // the newline ending the record starting at 'first', or nullptr if there isn't
+            // one.  In CSV a quoted field can have newlines in it.
+
+            const char* find_record_end(const char* first, const char* last) const
+            {
+                const char* newline = static_cast<const char*>(std::memchr(first, '\n', last - first));
+                if (options_.format != text_format::csv || std::memchr(first, '"', (newline == nullptr ? last : newline) - first) == nullptr)
+                {
+                    return newline;
+                }
+
+                bool quoted{false};
+                for (const char* p = first; p != last; ++p)
+                {
+                    if (*p == '"')
+                    {
+                        quoted = ! quoted;
+                    }
+                    else if (*p == '\n' && ! quoted)
+                    {
+                        return p;
+                    }
+                }
+                return nullptr;
+            }
+
+            static bool is_blank(const char* first, const char* last)
+            {
+                return std::all_of(first, last, [](char c) { return c == ' ' || c == '\t'; });
+            }
+
+            template<typename OnField>
+            void parse_csv(const char* p, const char* end, OnField& on_field)
+            {
+                const char delimiter = options_.delimiter;
+                while (true)
+                {
+                    if (p != end && *p == '"')
+                    {
+                        // "" inside quotes is one ".
+
+                        const char* start = ++p;
+                        bool escaped{false};
+                        while (true)
+                        {
+                            p = static_cast<const char*>(std::memchr(p, '"', end - p));
+                            if (p == nullptr)
+                            {
+                                fail("unterminated quoted field");
+                            }
+                            if (p + 1 != end && *(p + 1) == '"')
+                            {
+                                escaped = true;
+                                p += 2;
+                                continue;
+                            }
+                            break;
+                        }
+                        std::string_view text{start, static_cast<std::size_t>(p - start)};
+                        if (escaped)
+                        {
+                            scratch_.clear();
+                            for (const char* q = start; q != p; ++q)
+                            {
+                                scratch_.push_back(*q);
+                                q += *q == '"';
+                            }
+                            text = scratch_;
+                        }
+                        ++p;
+                        if (p != end && *p != delimiter)
+                        {
+                            fail("text after a quoted field");
+                        }
+                        on_field(text_field{text, field_kind::quoted});
+                    }
+                    else
+                    {
+                        const char* stop = static_cast<const char*>(std::memchr(p, delimiter, end - p));
+                        if (stop == nullptr)
+                        {
+                            stop = end;
+                        }
+                        on_field(text_field{std::string_view{p, static_cast<std::size_t>(stop - p)}, field_kind::bare});
+                        p = stop;
+                    }
+                    if (p == end)
+                    {
+                        return;
+                    }
+                    ++p;
+                }
+            }
+
+            static const char* skip_space(const char* p, const char* end)
+            {
+                while (p != end && (*p == ' ' || *p == '\t'))
+                {
+                    ++p;
+                }
+                return p;
+            }
+
+            template<typename OnField>
+            void parse_json(const char* p, const char* end, OnField& on_field)
+            {
+                p = skip_space(p, end);
+                const char open = *p;
+                if (open != '[' && open != '{')
+                {
+                    p = json_scalar(p, end, on_field);
+                }
+                else
+                {
+                    const char close = open == '[' ? ']' : '}';
+                    p = skip_space(p + 1, end);
+                    if (p != end && *p == close)
+                    {
+                        ++p;
+                    }
+                    else
+                    {
+                        while (true)
+                        {
+                            if (open == '{')
+                            {
+                                if (p == end || *p != '"')
+                                {
+                                    fail("expected a key");
+                                }
+                                p = skip_space(json_string(p, end), end);
+                                if (p == end || *p != ':')
+                                {
+                                    fail("expected ':'");
+                                }
+                                p = skip_space(p + 1, end);
+                            }
+                            p = skip_space(json_scalar(p, end, on_field), end);
+                            if (p != end && *p == close)
+                            {
+                                ++p;
+                                break;
+                            }
+                            if (p == end || *p != ',')
+                            {
+                                fail(std::string{"expected ',' or '"} + close + "'");
+                            }
+                            p = skip_space(p + 1, end);
+                        }
+                    }
+                }
+                if (skip_space(p, end) != end)
+                {
+                    fail("text after the end of the value");
+                }
+            }
+
+            // a JSON string starting at the '"' at 'p'.  Leaves it in json_text_.
+
+            const char* json_string(const char* p, const char* end)
+            {
+                const char* start = ++p;
+                while (p != end && *p != '"' && *p != '\\')
+                {
+                    ++p;
+                }
+                if (p != end && *p == '"')
+                {
+                    json_text_ = std::string_view{start, static_cast<std::size_t>(p - start)};
+                    return p + 1;
+                }
+
+                scratch_.assign(start, p);
+                while (p != end && *p != '"')
+                {
+                    if (*p != '\\')
+                    {
+                        scratch_.push_back(*p++);
+                        continue;
+                    }
+                    if (++p == end)
+                    {
+                        break;
+                    }
+                    switch (*p++)
+                    {
+                        case '"':   scratch_.push_back('"');    break;
+                        case '\\':  scratch_.push_back('\\');   break;
+                        case '/':   scratch_.push_back('/');    break;
+                        case 'b':   scratch_.push_back('\b');   break;
+                        case 'f':   scratch_.push_back('\f');   break;
+                        case 'n':   scratch_.push_back('\n');   break;
+                        case 'r':   scratch_.push_back('\r');   break;
+                        case 't':   scratch_.push_back('\t');   break;
+                        case 'u':
+                        {
+                            std::uint32_t code = hex4(p, end);
+                            p += 4;
+                            if (code >= 0xD800 && code < 0xDC00 && end - p >= 6 && *p == '\\' && *(p + 1) == 'u')
+                            {
+                                const std::uint32_t low = hex4(p + 2, end);
+                                if (low >= 0xDC00 && low < 0xE000)
+                                {
+                                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                                    p += 6;
+                                }
+                            }
+                            append_utf8(code);
+                            break;
+                        }
+                        default:
+                            fail("bad escape in string");
+                    }
+                }
+                if (p == end)
+                {
+                    fail("unterminated string");
+                }
+                json_text_ = scratch_;
+                return p + 1;
+            }
+
+            std::uint32_t hex4(const char* p, const char* end) const
+            {
+                std::uint32_t code{0};
+                if (end - p < 4 || std::from_chars(p, p + 4, code, 16).ptr != p + 4)
+                {
+                    fail("bad \\u escape");
+                }
+                return code;
+            }
+
+            void append_utf8(std::uint32_t code)
+            {
+                if (code < 0x80)
+                {
+                    scratch_.push_back(static_cast<char>(code));
+                }
+                else if (code < 0x800)
+                {
+                    scratch_.push_back(static_cast<char>(0xC0 | (code >> 6)));
+                    scratch_.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                }
+                else if (code < 0x10000)
+                {
+                    scratch_.push_back(static_cast<char>(0xE0 | (code >> 12)));
+                    scratch_.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                    scratch_.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                }
+                else
+                {
+                    scratch_.push_back(static_cast<char>(0xF0 | (code >> 18)));
+                    scratch_.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+                    scratch_.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                    scratch_.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                }
+            }
+
+            template<typename OnField>
+            const char* json_scalar(const char* p, const char* end, OnField& on_field)
+            {
+                if (p == end)
+                {
+                    fail("expected a value");
+                }
+                if (*p == '"')
+                {
+                    p = json_string(p, end);
+                    on_field(text_field{json_text_, field_kind::quoted});
+                    return p;
+                }
+                if (*p == '[' || *p == '{')
+                {
+                    fail("nested arrays and objects aren't supported");
+                }
+
+                const char* start = p;
+                while (p != end && *p != ',' && *p != ']' && *p != '}' && *p != ' ' && *p != '\t')
+                {
+                    ++p;
+                }
+                const std::string_view text{start, static_cast<std::size_t>(p - start)};
+                on_field(text_field{text, text == "null" ? field_kind::null : field_kind::bare});
+                return p;
+            }
+
+            /* ====================  DATA MEMBERS  ======================================= */
+
+            text_options options_;
+            std::string scratch_;
+            std::string_view json_text_;
+            std::size_t records_ = 0;
+            bool skip_next_;
+
+    }; /* ----------  end of class text_record_parser  ---------- */
+
+    /* ====================  LOADING         ======================================= */
+
+    // the whole of 'text' into one list.  The fields are counted roughly first, every
+    // delimiter and newline, so the list is reserved once.
+
+    template<typename List>
+    List parse_text(std::string_view text, const text_options& options = {})
+    {
+        const char separator = options.format == text_format::csv ? options.delimiter : ',';
+        const auto estimate = std::count_if(text.begin(), text.end(), [separator](char c) { return c == separator || c == '\n'; });
+
+        List result;
+        result.reserve(static_cast<std::size_t>(estimate) + 1);
+
+        text_record_parser parser{options};
+        parser.parse(text.data(), text.data() + text.size(), true,
+            [&](const text_field& field)
+            {
+                if (! append_inferred(result, field))
+                {
+                    parser.fail("no type in this list can hold '" + std::string{field.text} + "'");
+                }
+            },
+            []() { return true; });
+        return result;
+    }
+
+    // maps the file rather than reading it.
+
+    template<typename List>
+    List load_text(const std::string& file_name, const text_options& options = {})
+    {
+        const mapped_file file{file_name};
+        return parse_text<List>(std::string_view{file.data(), file.size()}, options);
+    }
+
+    // reads 'fd' options.block_size bytes at a time and calls on_row(List&) with each
+    // record.  The row is reused, so move or copy out of it whatever you want to keep,
+    // and only one block is held in memory at a time.  If on_row returns a bool, false
+    // stops the reading.  Returns the number of rows handed out.
+
+    template<typename List, typename F>
+    std::size_t for_each_text_row(int fd, F&& on_row, const text_options& options = {})
+    {
+        std::vector<char> buffer(std::max<std::size_t>(options.block_size, 4096));
+        std::size_t filled{0};
+        std::size_t rows{0};
+        bool at_eof{false};
+        bool stopped{false};
+
+        text_record_parser parser{options};
+        List row;
+
+        auto on_field = [&](const text_field& field)
+        {
+            if (! append_inferred(row, field))
+            {
+                parser.fail("no type in this list can hold '" + std::string{field.text} + "'");
+            }
+        };
+        auto on_record = [&]()
+        {
+            ++rows;
+            if constexpr(std::is_same_v<std::invoke_result_t<F&, List&>, bool>)
+            {
+                stopped = ! on_row(row);
+            }
+            else
+            {
+                on_row(row);
+            }
+            row.erase(0, row.size());
+            return ! stopped;
+        };
+
+        while (! at_eof && ! stopped)
+        {
+            if (filled == buffer.size())
+            {
+                // one record bigger than a block.
+
+                buffer.resize(buffer.size() * 2);
+            }
+            const ssize_t got = ::read(fd, buffer.data() + filled, buffer.size() - filled);
+            if (got < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throw std::system_error{errno, std::generic_category(), "error reading text"};
+            }
+            at_eof = got == 0;
+            filled += static_cast<std::size_t>(got);
+
+            const char* done = parser.parse(buffer.data(), buffer.data() + filled, at_eof, on_field, on_record);
+            const std::size_t used = done - buffer.data();
+            std::memmove(buffer.data(), done, filled - used);
+            filled -= used;
+        }
+        return rows;
+    }
+
+    template<typename List, typename F>
+    std::size_t for_each_text_row(const std::string& file_name, F&& on_row, const text_options& options = {})
+    {
+        const int fd = ::open(file_name.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw std::system_error{errno, std::generic_category(), "can't open: " + file_name};
+        }
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        try
+        {
+            const std::size_t rows = for_each_text_row<List>(fd, std::forward<F>(on_row), options);
+            ::close(fd);
+            return rows;
+        }
+        catch (...)
+        {
+            ::close(fd);
+            throw;
+        }
+    }
+}		/* -----  end of namespace cpp_like_py  ----- */
+
+#endif   /* ----- #ifndef _PY_VECTOR_TEXT_INC_  ----- */
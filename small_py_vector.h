@@ -0,0 +1,348 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  small_py_vector.h
+ *
+ *    Description:  py_vector which keeps up to N elements inside itself and only
+ *                  goes to the heap when it grows past that.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 03:26:40 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  David P. Riedel (), driedel@cox.net
+ *   Organization:
+ *
+ * =====================================================================================
+ */
+
+
+#ifndef  _SMALL_PY_VECTOR_INC_
+#define  _SMALL_PY_VECTOR_INC_
+
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+#include "py_vector.h"
+
+namespace cpp_like_py
+{
+    /*
+     * =====================================================================================
+     *        Class:  small_vector
+     *  Description:  vector-like container with room for N elements inline.
+     * =====================================================================================
+     */
+
+    // just enough of the std::vector interface for basic_py_vector.  Iterators are plain
+    // pointers.  Moving a small_vector which has spilled to the heap just takes the
+    // heap buffer.  Moving one which is still inline has to move the elements.
+
+    template<typename T, std::size_t N>
+    class small_vector
+    {
+        static_assert(N > 0, "small_vector needs room for at least 1 element.");
+
+        public:
+
+            using value_type = T;
+            using size_type = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using reference = T&;
+            using const_reference = const T&;
+            using pointer = T*;
+            using const_pointer = const T*;
+            using iterator = T*;
+            using const_iterator = const T*;
+
+            /* ====================  LIFECYCLE     ======================================= */
+            small_vector () noexcept : data_{inline_data()} { }                 /* constructor */
+
+            ~small_vector ()
+            {
+                clear();
+                release_heap();
+            }
+
+            small_vector (std::initializer_list<T> values) : small_vector()
+            {
+                reserve(values.size());
+                std::uninitialized_copy(values.begin(), values.end(), data_);
+                size_ = values.size();
+            }
+
+            small_vector (const small_vector& rhs) : small_vector()
+            {
+                reserve(rhs.size_);
+                std::uninitialized_copy(rhs.begin(), rhs.end(), data_);
+                size_ = rhs.size_;
+            }
+
+            small_vector (small_vector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>) : small_vector()
+            {
+                take_contents(std::move(rhs));
+            }
+
+            /* ====================  ACCESSORS     ======================================= */
+
+            size_type size() const noexcept { return size_; }
+            size_type capacity() const noexcept { return capacity_; }
+            bool empty() const noexcept { return size_ == 0; }
+
+            // true as long as we haven't needed the heap.
+
+            bool is_inline() const noexcept { return data_ == inline_data(); }
+
+            T* data() noexcept { return data_; }
+            const T* data() const noexcept { return data_; }
+
+            iterator begin() noexcept { return data_; }
+            const_iterator begin() const noexcept { return data_; }
+            const_iterator cbegin() const noexcept { return data_; }
+            iterator end() noexcept { return data_ + size_; }
+            const_iterator end() const noexcept { return data_ + size_; }
+            const_iterator cend() const noexcept { return data_ + size_; }
+
+            T& operator[](size_type index) { return data_[index]; }
+            const T& operator[](size_type index) const { return data_[index]; }
+
+            T& at(size_type index)
+            {
+                if (index >= size_)
+                {
+                    throw std::out_of_range{"small_vector::at"};
+                }
+                return data_[index];
+            }
+
+            const T& at(size_type index) const
+            {
+                if (index >= size_)
+                {
+                    throw std::out_of_range{"small_vector::at"};
+                }
+                return data_[index];
+            }
+
+            T& front() { return data_[0]; }
+            const T& front() const { return data_[0]; }
+            T& back() { return data_[size_ - 1]; }
+            const T& back() const { return data_[size_ - 1]; }
+
+            /* ====================  MUTATORS      ======================================= */
+
+            void reserve(size_type new_capacity)
+            {
+                if (new_capacity > capacity_)
+                {
+                    grow_to(new_capacity);
+                }
+            }
+
+            void clear() noexcept
+            {
+                std::destroy(data_, data_ + size_);
+                size_ = 0;
+            }
+
+            template<typename ...Args>
+            T& emplace_back(Args&& ...args)
+            {
+                if (size_ == capacity_)
+                {
+                    // build the new element before moving the old ones in case
+                    // the arguments refer to one of them.
+
+                    const size_type new_capacity = capacity_ * 2;
+                    T* new_data = std::allocator<T>{}.allocate(new_capacity);
+                    try
+                    {
+                        ::new (static_cast<void*>(new_data + size_)) T(std::forward<Args>(args)...);
+                    }
+                    catch (...)
+                    {
+                        std::allocator<T>{}.deallocate(new_data, new_capacity);
+                        throw;
+                    }
+                    move_to(new_data, new_capacity);
+                }
+                else
+                {
+                    ::new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+                }
+                return data_[size_++];
+            }
+
+            void push_back(const T& value) { emplace_back(value); }
+            void push_back(T&& value) { emplace_back(std::move(value)); }
+
+            void pop_back()
+            {
+                std::destroy_at(data_ + size_ - 1);
+                --size_;
+            }
+
+            template<typename ...Args>
+            iterator emplace(const_iterator pos, Args&& ...args)
+            {
+                const size_type where = pos - data_;
+                if (where == size_)
+                {
+                    emplace_back(std::forward<Args>(args)...);
+                }
+                else
+                {
+                    T new_value(std::forward<Args>(args)...);
+                    emplace_back(std::move(back()));
+                    std::move_backward(data_ + where, data_ + size_ - 2, data_ + size_ - 1);
+                    data_[where] = std::move(new_value);
+                }
+                return data_ + where;
+            }
+
+            iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+            iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+            template<typename InputIt>
+            iterator insert(const_iterator pos, InputIt first, InputIt last)
+            {
+                // put them on the end then rotate them into place.
+
+                const size_type where = pos - data_;
+                const size_type old_size = size_;
+                for (; first != last; ++first)
+                {
+                    emplace_back(*first);
+                }
+                std::rotate(data_ + where, data_ + old_size, data_ + size_);
+                return data_ + where;
+            }
+
+            iterator erase(const_iterator first, const_iterator last)
+            {
+                T* from = data_ + (first - data_);
+                T* to = data_ + (last - data_);
+                if (from != to)
+                {
+                    T* new_end = std::move(to, data_ + size_, from);
+                    std::destroy(new_end, data_ + size_);
+                    size_ = new_end - data_;
+                }
+                return from;
+            }
+
+            iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+            /* ====================  OPERATORS     ======================================= */
+
+            small_vector& operator=(const small_vector& rhs)
+            {
+                if (this != &rhs)
+                {
+                    small_vector new_values{rhs};
+                    *this = std::move(new_values);
+                }
+                return *this;
+            }
+
+            small_vector& operator=(small_vector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>)
+            {
+                if (this != &rhs)
+                {
+                    clear();
+                    release_heap();
+                    take_contents(std::move(rhs));
+                }
+                return *this;
+            }
+
+            bool operator==(const small_vector& rhs) const
+            {
+                return size_ == rhs.size_ && std::equal(begin(), end(), rhs.begin());
+            }
+
+            bool operator!=(const small_vector& rhs) const { return ! (*this == rhs); }
+
+        private:
+            /* ====================  METHODS       ======================================= */
+
+            T* inline_data() noexcept { return std::launder(reinterpret_cast<T*>(inline_buffer_)); }
+            const T* inline_data() const noexcept { return std::launder(reinterpret_cast<const T*>(inline_buffer_)); }
+
+            void release_heap() noexcept
+            {
+                if (! is_inline())
+                {
+                    std::allocator<T>{}.deallocate(data_, capacity_);
+                    data_ = inline_data();
+                    capacity_ = N;
+                }
+            }
+
+            // move our elements into 'new_data' (already allocated) and make it our storage.
+
+            void move_to(T* new_data, size_type new_capacity) noexcept
+            {
+                std::uninitialized_move(data_, data_ + size_, new_data);
+                std::destroy(data_, data_ + size_);
+                release_heap();
+                data_ = new_data;
+                capacity_ = new_capacity;
+            }
+
+            void grow_to(size_type new_capacity)
+            {
+                T* new_data = std::allocator<T>{}.allocate(new_capacity);
+                move_to(new_data, new_capacity);
+            }
+
+            // we must be empty and inline.
+
+            void take_contents(small_vector&& rhs)
+            {
+                if (rhs.is_inline())
+                {
+                    std::uninitialized_move(rhs.data_, rhs.data_ + rhs.size_, data_);
+                    size_ = rhs.size_;
+                    rhs.clear();
+                }
+                else
+                {
+                    data_ = rhs.data_;
+                    size_ = rhs.size_;
+                    capacity_ = rhs.capacity_;
+                    rhs.data_ = rhs.inline_data();
+                    rhs.size_ = 0;
+                    rhs.capacity_ = N;
+                }
+            }
+
+            /* ====================  DATA MEMBERS  ======================================= */
+
+            alignas(T) unsigned char inline_buffer_[N * sizeof(T)];
+            T* data_;
+            size_type size_ = 0;
+            size_type capacity_ = N;
+
+    }; /* ----------  end of template class small_vector  ---------- */
+}		/* -----  end of namespace cpp_like_py  ----- */
+
+// storage policy for basic_py_vector which keeps up to N elements inline.
+
+template<std::size_t N>
+struct inline_storage
+{
+    template<typename V>
+        using container_t = cpp_like_py::small_vector<V, N>;
+};
+
+// small_py_vector<8, int, std::string> x{1, "ab"}; never touches the heap for the list
+// itself until it holds more than 8 elements.  It interoperates with any py_vector
+// whose type signature is compatible.
+
+template<std::size_t N, typename ...Ts>
+        using small_py_vector = basic_py_vector<inline_storage<N>, Ts...>;
+
+#endif   /* ----- #ifndef _SMALL_PY_VECTOR_INC_  ----- */
@@ -0,0 +1,789 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  spill_py_vector.h
+ *
+ *    Description:  py_vector which keeps most of its elements on disk, in a memory
+ *                  mapped spill file, and only a budgeted few chunks in memory.
+ *
+ *        Version:  1.0
+ *        Created:  10/19/2026 10:04:51 AM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  David P. Riedel (), driedel@cox.net
+ *   Organization:
+ *
+ * =====================================================================================
+ */
+
+
+#ifndef  _SPILL_PY_VECTOR_INC_
+#define  _SPILL_PY_VECTOR_INC_
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "py_vector_io.h"
+
+namespace cpp_like_py
+{
+    struct spill_options
+    {
+        std::size_t memory_budget = std::size_t{256} << 20;    // bytes of chunks kept in memory
+        std::size_t prefetch_chunks = 2;                        // read ahead this many when scanning
+        std::string directory;                                  // for the spill file.  Empty is $TMPDIR or /tmp.
+    };
+
+    // what each new spill_py_vector starts with.  Change it before making the lists it
+    // should apply to.
+
+    inline spill_options& spill_defaults()
+    {
+        static spill_options options;
+        return options;
+    }
+
+    // lets serial_traits write a chunk into memory.
+
+    class spill_sink : public std::streambuf
+    {
+        public:
+
+            explicit spill_sink(std::vector<char>& out) : out_{out} { }
+
+        protected:
+
+            int_type overflow(int_type c) override
+            {
+                if (! traits_type::eq_int_type(c, traits_type::eof()))
+                {
+                    out_.push_back(traits_type::to_char_type(c));
+                }
+                return c;
+            }
+
+            std::streamsize xsputn(const char* s, std::streamsize count) override
+            {
+                out_.insert(out_.end(), s, s + count);
+                return count;
+            }
+
+        private:
+
+            std::vector<char>& out_;
+    };
+
+    // a chunk of variants in the py_vector_io.h element encoding: a tag then the payload.
+
+    template<typename T>
+    struct spill_codec
+    {
+        static_assert(sizeof(T) == 0, "spill_vector holds the std::variant of a py_vector's type signature.");
+    };
+
+    template<typename ...Ts>
+    struct spill_codec<std::variant<Ts...>>
+    {
+        using tag_t = type_tag_t<sizeof...(Ts)>;
+
+        template<typename Iterator>
+        static void encode(std::ostream& out, Iterator first, Iterator last)
+        {
+            for (; first != last; ++first)
+            {
+                mp11::mp_with_index<sizeof...(Ts)>(first->index(), [&](auto I)
+                {
+                    using X = std::variant_alternative_t<I, std::variant<Ts...>>;
+                    write_raw(out, static_cast<tag_t>(I));
+                    serial_traits<X>::write(out, *std::get_if<I>(&*first));
+                });
+            }
+        }
+
+        // about what encode() writes for 'value', which is also about what it has on the
+        // heap.
+
+        static std::size_t encoded_size(const std::variant<Ts...>& value)
+        {
+            return sizeof(tag_t) + std::visit([](const auto& x) -> std::size_t
+            {
+                using X = std::decay_t<decltype(x)>;
+                if constexpr(std::is_arithmetic_v<X>)
+                {
+                    return sizeof(X);
+                }
+                else if constexpr(std::is_convertible_v<const X&, std::string_view>)
+                {
+                    return sizeof(std::uint64_t) + std::string_view{x}.size();
+                }
+                else
+                {
+                    return sizeof(X);
+                }
+            }, value);
+        }
+
+        static void decode(byte_reader& in, std::size_t count, std::vector<std::variant<Ts...>>& values)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const auto tag = in.read<tag_t>();
+                if (tag >= sizeof...(Ts))
+                {
+                    throw py_vector_format_error{"bad type tag in spill file."};
+                }
+                mp11::mp_with_index<sizeof...(Ts)>(tag, [&](auto I)
+                {
+                    using X = std::variant_alternative_t<I, std::variant<Ts...>>;
+                    values.emplace_back(std::in_place_index<I>, serial_traits<X>::read(in));
+                });
+            }
+        }
+    };
+
+    /*
+     * =====================================================================================
+     *        Class:  spill_vector
+     *  Description:  vector-like container which spills to a file once it is bigger than
+     *                its memory budget.
+     * =====================================================================================
+     */
+
+    // just enough of the std::vector interface for basic_py_vector.
+    //
+    // The elements are in chunks of ChunkElements, all full but the last.  A chunk is
+    // either in memory, as a std::vector<T>, or encoded in the spill file, or both.  When
+    // a chunk has to come into memory and the ones already there use up the budget, the
+    // least recently used goes out, being written first if it has changed.  A rewritten
+    // chunk goes back where it was if it fits, else on the end of the file.  The file is
+    // made on the first spill and deleted as soon as it is opened so it can't be left
+    // behind.
+    //
+    // Chunks are read by mapping their part of the file.  Reading chunk after chunk
+    // front to back asks the kernel to start reading the next prefetch_chunks as well so
+    // a scan doesn't wait on the disk.
+    //
+    // Indexing is a compare against the last chunk used, so going through the list in
+    // order costs little more than std::vector.  References and pointers to elements stay
+    // good until the chunk they are in is pushed out: at least until min_resident - 1
+    // other chunks have been used.  Even reading changes which chunks are in memory so,
+    // unlike std::vector, only one thread at a time may use the container.
+
+    template<typename T, std::size_t ChunkElements = 65536>
+    class spill_vector
+    {
+        static_assert(ChunkElements != 0 && (ChunkElements & (ChunkElements - 1)) == 0, "ChunkElements must be a power of 2.");
+
+        public:
+
+            using value_type = T;
+            using size_type = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using reference = T&;
+            using const_reference = const T&;
+            using pointer = T*;
+            using const_pointer = const T*;
+
+            static constexpr bool single_threaded = true;
+            static constexpr size_type min_resident = 4;
+
+            template<bool Const>
+            class basic_iterator
+            {
+                public:
+
+                    using iterator_category = std::random_access_iterator_tag;
+                    using value_type = T;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = std::conditional_t<Const, const T*, T*>;
+                    using reference = std::conditional_t<Const, const T&, T&>;
+                    using vector_t = std::conditional_t<Const, const spill_vector, spill_vector>;
+
+                    basic_iterator() = default;
+                    basic_iterator(vector_t* vector, difference_type pos) : vector_{vector}, pos_{pos} { }
+
+                    // an iterator converts to a const_iterator.
+
+                    template<bool C = Const, typename = std::enable_if_t<C>>
+                    basic_iterator(const basic_iterator<false>& rhs) : vector_{rhs.vector_}, pos_{rhs.pos_} { }
+
+                    reference operator*() const { return (*vector_)[static_cast<size_type>(pos_)]; }
+                    pointer operator->() const { return &**this; }
+                    reference operator[](difference_type n) const { return (*vector_)[static_cast<size_type>(pos_ + n)]; }
+
+                    basic_iterator& operator++() { ++pos_; return *this; }
+                    basic_iterator operator++(int) { auto result{*this}; ++pos_; return result; }
+                    basic_iterator& operator--() { --pos_; return *this; }
+                    basic_iterator operator--(int) { auto result{*this}; --pos_; return result; }
+                    basic_iterator& operator+=(difference_type n) { pos_ += n; return *this; }
+                    basic_iterator& operator-=(difference_type n) { pos_ -= n; return *this; }
+                    basic_iterator operator+(difference_type n) const { return basic_iterator{vector_, pos_ + n}; }
+                    basic_iterator operator-(difference_type n) const { return basic_iterator{vector_, pos_ - n}; }
+                    friend basic_iterator operator+(difference_type n, const basic_iterator& it) { return it + n; }
+                    difference_type operator-(const basic_iterator& rhs) const { return pos_ - rhs.pos_; }
+
+                    bool operator==(const basic_iterator& rhs) const { return pos_ == rhs.pos_; }
+                    bool operator!=(const basic_iterator& rhs) const { return pos_ != rhs.pos_; }
+                    bool operator<(const basic_iterator& rhs) const { return pos_ < rhs.pos_; }
+                    bool operator>(const basic_iterator& rhs) const { return pos_ > rhs.pos_; }
+                    bool operator<=(const basic_iterator& rhs) const { return pos_ <= rhs.pos_; }
+                    bool operator>=(const basic_iterator& rhs) const { return pos_ >= rhs.pos_; }
+
+                    difference_type position() const { return pos_; }
+
+                private:
+
+                    template<bool> friend class basic_iterator;
+
+                    vector_t* vector_ = nullptr;
+                    difference_type pos_ = 0;
+            };
+
+            using iterator = basic_iterator<false>;
+            using const_iterator = basic_iterator<true>;
+
+            /* ====================  LIFECYCLE     ======================================= */
+            spill_vector () : options_{spill_defaults()} { }                   /* constructor */
+
+            explicit spill_vector (const spill_options& options) : options_{options} { }
+
+            ~spill_vector ()
+            {
+                if (fd_ >= 0)
+                {
+                    ::close(fd_);
+                }
+            }
+
+            spill_vector (std::initializer_list<T> values) : spill_vector{}
+            {
+                for (const auto& value : values)
+                {
+                    emplace_back(value);
+                }
+            }
+
+            spill_vector (const spill_vector& rhs) : options_{rhs.options_}
+            {
+                reserve(rhs.size());
+                for (const auto& value : rhs)
+                {
+                    emplace_back(value);
+                }
+            }
+
+            spill_vector (spill_vector&& rhs) noexcept
+                : options_{std::move(rhs.options_)}, chunks_{std::move(rhs.chunks_)}, resident_{std::move(rhs.resident_)},
+                size_{std::exchange(rhs.size_, 0)}, fd_{std::exchange(rhs.fd_, -1)}, file_size_{std::exchange(rhs.file_size_, 0)},
+                tick_{rhs.tick_}, last_loaded_{rhs.last_loaded_}
+            {
+                rhs.forget_hot();
+                rhs.chunks_.clear();
+                rhs.resident_.clear();
+            }
+
+            /* ====================  ACCESSORS     ======================================= */
+
+            size_type size() const noexcept { return size_; }
+            size_type capacity() const noexcept { return chunks_.size() * ChunkElements; }
+            bool empty() const noexcept { return size_ == 0; }
+
+            iterator begin() noexcept { return {this, 0}; }
+            const_iterator begin() const noexcept { return {this, 0}; }
+            const_iterator cbegin() const noexcept { return {this, 0}; }
+            iterator end() noexcept { return {this, static_cast<difference_type>(size_)}; }
+            const_iterator end() const noexcept { return {this, static_cast<difference_type>(size_)}; }
+            const_iterator cend() const noexcept { return {this, static_cast<difference_type>(size_)}; }
+
+            T& operator[](size_type index)
+            {
+                const size_type which = index / ChunkElements;
+                if (which != hot_chunk_ || ! hot_dirty_)
+                {
+                    make_hot(which, true);
+                }
+                return hot_values_[index % ChunkElements];
+            }
+
+            const T& operator[](size_type index) const
+            {
+                const size_type which = index / ChunkElements;
+                if (which != hot_chunk_)
+                {
+                    make_hot(which, false);
+                }
+                return hot_values_[index % ChunkElements];
+            }
+
+            T& front() { return (*this)[0]; }
+            const T& front() const { return (*this)[0]; }
+            T& back() { return (*this)[size_ - 1]; }
+            const T& back() const { return (*this)[size_ - 1]; }
+
+            // how many chunks are in memory and how big the spill file is.
+
+            size_type resident_chunks() const noexcept { return resident_.size(); }
+            std::uint64_t spilled_bytes() const noexcept { return file_size_; }
+
+            /* ====================  MUTATORS      ======================================= */
+
+            void reserve(size_type new_capacity)
+            {
+                chunks_.reserve((new_capacity + ChunkElements - 1) / ChunkElements);
+            }
+
+            void clear()
+            {
+                chunks_.clear();
+                resident_.clear();
+                size_ = 0;
+                forget_hot();
+                if (fd_ >= 0 && ::ftruncate(fd_, 0) == 0)
+                {
+                    file_size_ = 0;
+                }
+            }
+
+            template<typename ...Args>
+            T& emplace_back(Args&& ...args)
+            {
+                // the arguments may refer to an element in a chunk which is about to be
+                // pushed out.
+
+                T new_value(std::forward<Args>(args)...);
+                const size_type which = size_ / ChunkElements;
+                if (which == chunks_.size())
+                {
+                    add_chunk();
+                }
+                else if (which != hot_chunk_ || ! hot_dirty_)
+                {
+                    make_hot(which, true);
+                }
+                chunks_[which].heap_bytes += spill_codec<T>::encoded_size(new_value);
+                T& result = chunks_[which].values.emplace_back(std::move(new_value));
+                ++size_;
+                return result;
+            }
+
+            void push_back(const T& value) { emplace_back(value); }
+            void push_back(T&& value) { emplace_back(std::move(value)); }
+
+            void pop_back()
+            {
+                truncate(size_ - 1);
+            }
+
+            // everything after 'pos' moves up one, a chunk at a time.
+
+            template<typename ...Args>
+            iterator emplace(const_iterator pos, Args&& ...args)
+            {
+                const auto where = static_cast<size_type>(pos.position());
+                T new_value(std::forward<Args>(args)...);
+                if (where == size_)
+                {
+                    emplace_back(std::move(new_value));
+                }
+                else
+                {
+                    T last{std::move((*this)[size_ - 1])};
+                    for (size_type i = size_ - 1; i > where; --i)
+                    {
+                        (*this)[i] = std::move((*this)[i - 1]);
+                    }
+                    (*this)[where] = std::move(new_value);
+                    emplace_back(std::move(last));
+                }
+                return {this, static_cast<difference_type>(where)};
+            }
+
+            iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+            iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+            iterator erase(const_iterator first, const_iterator last)
+            {
+                const auto from = static_cast<size_type>(first.position());
+                const auto count = static_cast<size_type>(last.position() - first.position());
+                if (count != 0)
+                {
+                    for (size_type i = from; i + count < size_; ++i)
+                    {
+                        (*this)[i] = std::move((*this)[i + count]);
+                    }
+                    truncate(size_ - count);
+                }
+                return {this, static_cast<difference_type>(from)};
+            }
+
+            iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+            /* ====================  OPERATORS     ======================================= */
+
+            spill_vector& operator=(const spill_vector& rhs)
+            {
+                if (this != &rhs)
+                {
+                    spill_vector new_values{rhs};
+                    *this = std::move(new_values);
+                }
+                return *this;
+            }
+
+            spill_vector& operator=(spill_vector&& rhs) noexcept
+            {
+                if (this != &rhs)
+                {
+                    if (fd_ >= 0)
+                    {
+                        ::close(fd_);
+                    }
+                    options_ = std::move(rhs.options_);
+                    chunks_ = std::move(rhs.chunks_);
+                    resident_ = std::move(rhs.resident_);
+                    size_ = std::exchange(rhs.size_, 0);
+                    fd_ = std::exchange(rhs.fd_, -1);
+                    file_size_ = std::exchange(rhs.file_size_, 0);
+                    tick_ = rhs.tick_;
+                    last_loaded_ = rhs.last_loaded_;
+                    forget_hot();
+                    rhs.forget_hot();
+                    rhs.chunks_.clear();
+                    rhs.resident_.clear();
+                }
+                return *this;
+            }
+
+            bool operator==(const spill_vector& rhs) const
+            {
+                return size_ == rhs.size_ && std::equal(begin(), end(), rhs.begin());
+            }
+
+            bool operator!=(const spill_vector& rhs) const { return ! (*this == rhs); }
+
+        private:
+
+            static constexpr size_type no_chunk = std::numeric_limits<size_type>::max();
+
+            struct chunk
+            {
+                std::vector<T> values;          // empty unless it is in memory
+                std::uint64_t offset = 0;       // where it was last written in the spill file
+                std::uint64_t length = 0;       // 0 if it never has been
+                std::uint64_t heap_bytes = 0;   // about what its elements have on the heap
+                std::size_t last_used = 0;
+                bool resident = false;
+                bool dirty = false;             // changed since it was last written
+            };
+
+            /* ====================  METHODS       ======================================= */
+
+            size_type elements_in(size_type which) const noexcept
+            {
+                return std::min(ChunkElements, size_ - which * ChunkElements);
+            }
+
+            // what a chunk costs in memory.  heap_bytes is its encoded length, kept up to
+            // date as it is appended to, since that is about what its elements have on
+            // the heap.  Changes made through operator[] are only counted once the chunk
+            // has been written.
+
+            size_type cost(const chunk& c) const noexcept
+            {
+                return ChunkElements * sizeof(T) + c.heap_bytes;
+            }
+
+            void forget_hot() const noexcept
+            {
+                hot_chunk_ = no_chunk;
+                hot_values_ = nullptr;
+                hot_dirty_ = false;
+            }
+
+            void make_hot(size_type which, bool writing) const
+            {
+                chunk& target = chunks_[which];
+                if (! target.resident)
+                {
+                    load(which);
+                }
+                target.last_used = ++tick_;
+                target.dirty = target.dirty || writing;
+                hot_chunk_ = which;
+                hot_values_ = target.values.data();
+                hot_dirty_ = target.dirty;
+            }
+
+            // the chunk after the last full one.  New chunks start out changed since they
+            // have never been written.
+
+            void add_chunk()
+            {
+                make_room(ChunkElements * sizeof(T));
+                chunks_.emplace_back();
+                chunk& tail = chunks_.back();
+                tail.values.reserve(ChunkElements);
+                tail.resident = true;
+                tail.dirty = true;
+                resident_.push_back(chunks_.size() - 1);
+                make_hot(chunks_.size() - 1, true);
+            }
+
+            // push out least recently used chunks until there's room for one costing
+            // 'incoming', keeping at least min_resident - 1.
+
+            void make_room(size_type incoming) const
+            {
+                while (resident_.size() >= min_resident)
+                {
+                    size_type in_use{0};
+                    for (const auto which : resident_)
+                    {
+                        in_use += cost(chunks_[which]);
+                    }
+                    if (in_use + incoming <= options_.memory_budget)
+                    {
+                        break;
+                    }
+                    const auto oldest = std::min_element(resident_.begin(), resident_.end(),
+                        [this](size_type a, size_type b) { return chunks_[a].last_used < chunks_[b].last_used; });
+                    evict(*oldest);
+                }
+            }
+
+            void evict(size_type which) const
+            {
+                chunk& victim = chunks_[which];
+                if (victim.dirty)
+                {
+                    write(victim);
+                }
+
+                // keep one chunk's worth of memory for the next load rather than giving it
+                // back and faulting it in again.
+
+                victim.values.clear();
+                if (spare_.capacity() == 0)
+                {
+                    spare_.swap(victim.values);
+                }
+                std::vector<T>{}.swap(victim.values);
+                victim.resident = false;
+                victim.dirty = false;
+                resident_.erase(std::find(resident_.begin(), resident_.end(), which));
+                if (hot_chunk_ == which)
+                {
+                    forget_hot();
+                }
+            }
+
+            void write(chunk& victim) const
+            {
+                encoded_.clear();
+                {
+                    spill_sink sink{encoded_};
+                    std::ostream out{&sink};
+                    spill_codec<T>::encode(out, victim.values.begin(), victim.values.end());
+                }
+                if (fd_ < 0)
+                {
+                    open_spill_file();
+                }
+
+                // back where it was if it fits.
+
+                if (encoded_.size() > victim.length)
+                {
+                    victim.offset = file_size_;
+                    file_size_ += encoded_.size();
+                }
+                victim.length = encoded_.size();
+                victim.heap_bytes = victim.length;
+
+                const char* data = encoded_.data();
+                std::size_t remaining = encoded_.size();
+                off_t where = static_cast<off_t>(victim.offset);
+                while (remaining != 0)
+                {
+                    const ssize_t written = ::pwrite(fd_, data, remaining, where);
+                    if (written < 0)
+                    {
+                        if (errno == EINTR)
+                        {
+                            continue;
+                        }
+                        throw std::system_error{errno, std::generic_category(), "can't write spill file"};
+                    }
+                    data += written;
+                    remaining -= static_cast<std::size_t>(written);
+                    where += written;
+                }
+            }
+
+            void load(size_type which) const
+            {
+                make_room(cost(chunks_[which]));
+
+                chunk& target = chunks_[which];
+                target.values.swap(spare_);
+                target.values.reserve(ChunkElements);
+
+                // mmap wants a page aligned offset.
+
+                static const std::uint64_t page_size = static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE));
+                const std::uint64_t start = target.offset - target.offset % page_size;
+                const std::size_t map_length = static_cast<std::size_t>(target.offset + target.length - start);
+
+                void* mapped = ::mmap(nullptr, map_length, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd_, static_cast<off_t>(start));
+                if (mapped == MAP_FAILED)
+                {
+                    throw std::system_error{errno, std::generic_category(), "can't map spill file"};
+                }
+                try
+                {
+                    const char* first = static_cast<const char*>(mapped) + (target.offset - start);
+                    byte_reader in{first, first + target.length};
+                    spill_codec<T>::decode(in, elements_in(which), target.values);
+                }
+                catch (...)
+                {
+                    ::munmap(mapped, map_length);
+                    target.values.clear();
+                    throw;
+                }
+                ::munmap(mapped, map_length);
+
+                target.resident = true;
+                resident_.push_back(which);
+
+                // going through in order.  Have the kernel start on what comes next.
+
+                if (which == last_loaded_ + 1)
+                {
+                    for (size_type next = which + 1; next <= which + options_.prefetch_chunks && next < chunks_.size(); ++next)
+                    {
+                        if (! chunks_[next].resident && chunks_[next].length != 0)
+                        {
+                            ::posix_fadvise(fd_, static_cast<off_t>(chunks_[next].offset), static_cast<off_t>(chunks_[next].length),
+                                POSIX_FADV_WILLNEED);
+                        }
+                    }
+                }
+                last_loaded_ = which;
+            }
+
+            void open_spill_file() const
+            {
+                std::string directory = options_.directory;
+                if (directory.empty())
+                {
+                    const char* tmp = std::getenv("TMPDIR");
+                    directory = tmp != nullptr && *tmp != '\0' ? tmp : "/tmp";
+                }
+                std::string name = directory + "/py_vector_spill_XXXXXX";
+                fd_ = ::mkstemp(name.data());
+                if (fd_ < 0)
+                {
+                    throw std::system_error{errno, std::generic_category(), "can't create spill file in: " + directory};
+                }
+                ::unlink(name.c_str());
+            }
+
+            // drop everything from 'new_size' on.
+
+            void truncate(size_type new_size)
+            {
+                const size_type keep_chunks = (new_size + ChunkElements - 1) / ChunkElements;
+                for (size_type which = keep_chunks; which < chunks_.size(); ++which)
+                {
+                    if (chunks_[which].resident)
+                    {
+                        resident_.erase(std::find(resident_.begin(), resident_.end(), which));
+                    }
+                }
+                chunks_.resize(keep_chunks);
+                if (hot_chunk_ != no_chunk && hot_chunk_ >= keep_chunks)
+                {
+                    forget_hot();
+                }
+                if (const size_type in_last = new_size % ChunkElements; in_last != 0)
+                {
+                    make_hot(keep_chunks - 1, true);
+                    auto& values = chunks_[keep_chunks - 1].values;
+                    values.erase(values.begin() + in_last, values.end());
+                    chunks_[keep_chunks - 1].heap_bytes = std::accumulate(values.begin(), values.end(), std::uint64_t{0},
+                        [](std::uint64_t total, const T& x) { return total + spill_codec<T>::encoded_size(x); });
+                }
+                size_ = new_size;
+                if (chunks_.empty())
+                {
+                    clear();
+                }
+            }
+
+            /* ====================  DATA MEMBERS  ======================================= */
+
+            spill_options options_;
+
+            // what is in memory changes even when we're only being read.
+
+            mutable std::vector<chunk> chunks_;
+            mutable std::vector<size_type> resident_;
+            size_type size_ = 0;
+
+            mutable int fd_ = -1;
+            mutable std::uint64_t file_size_ = 0;
+            mutable std::vector<char> encoded_;
+            mutable std::vector<T> spare_;
+
+            mutable std::size_t tick_ = 0;
+            mutable size_type last_loaded_ = no_chunk;
+
+            // the chunk we used last.
+
+            mutable size_type hot_chunk_ = no_chunk;
+            mutable T* hot_values_ = nullptr;
+            mutable bool hot_dirty_ = false;
+
+    }; /* ----------  end of template class spill_vector  ---------- */
+}		/* -----  end of namespace cpp_like_py  ----- */
+
+// storage policy for basic_py_vector which spills to disk.  ChunkElements is how many
+// elements are read or written at a time.
+
+template<std::size_t ChunkElements = 65536>
+struct spill_storage
+{
+    template<typename V>
+        using container_t = cpp_like_py::spill_vector<V, ChunkElements>;
+};
+
+// spill_py_vector<int, std::string> x; holds as many elements as there is disk for in
+// cpp_like_py::spill_defaults().memory_budget bytes of memory.  Indexing, append, slice,
+// visit_all, etc. work as they do for py_vector, but one list can't be used, even read,
+// on more than one thread at a time and par does its work with seq.  All the types in
+// the signature need a cpp_like_py::serial_traits, see py_vector_io.h.
+
+template<typename ...Ts>
+        using spill_py_vector = basic_py_vector<spill_storage<>, Ts...>;
+
+#endif   /* ----- #ifndef _SPILL_PY_VECTOR_INC_  ----- */